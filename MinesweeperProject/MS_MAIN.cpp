@@ -56,7 +56,14 @@ MS_solver.cpp, MS_solver.h
 #include <cassert> // so it aborts when something wierd happens
 #include <ctime> // logfile timestamp
 #include <chrono> // used to seed the RNG because time(0) only has 1-second resolution
-#include <random> // because I don't like using sequential seeds, or waiting when going very fast
+#include <unordered_set> // infinite-mode frontier
+#include <thread> // -threads workers
+#include <mutex> // keeps one game's log lines together
+#include <atomic> // next-game counter
+#include <algorithm> // sorting the crashed games
+#include <csignal> // ctrl+c writes a checkpoint
+#include <deque> // -paired solver contexts, which can't be copied or moved
+#include <climits> // INT_MAX, the most games one run can have
 #include <Windows.h> // needed to create LOGS directory
 #include <WinBase.h> // needed to test for existing logfile
 
@@ -65,6 +72,10 @@ MS_solver.cpp, MS_solver.h
 #include "MS_basegame.h"
 #include "MS_stats.h"
 #include "MS_solver.h"
+#include "MS_chunkgame.h"
+#include "MS_threadpool.h"
+#include "MS_workers.h"
+#include "MS_pipeline.h"
 
 
 
@@ -78,17 +89,62 @@ MS_solver.cpp, MS_solver.h
 bool FIND_EARLY_ZEROS_var = false; // TODO: may want to eliminate this option so i can hide zerolist and get perfect privacy enforcement???
 int GUESSING_MODE_var = 0; // 0/1/2, controls random/smartguess/perfectmode
 bool USE_END_PAUSE_var = false; // if using -prompt or -def or no args, then set this to true
-
-class game mygame = game();					// init empty, will fill the field_blank later
+long long INFINITE_BUDGET_var = 0; // if nonzero, play on an unbounded field until a loss or this many cells are revealed
+int THREADS_var = 1; // how many games to play at once, each on its own thread
+int TILE_THREADS_var = 1; // how many threads split up the logic rounds inside one game (1 = all serial, like always)
+unsigned long long RUNSEED_var = 0; // if nonzero, use this run seed instead of one from the time (so a run can be split into shards)
+int SHARD_var = 1; // which slice of the games to play, 1-based...
+int NUM_SHARDS_var = 1; // ...out of this many; 1/1 = all of them
+char * STATSOUT_var = NULL; // if set, save the run stats here in binary once done, for -merge
+std::vector<char *> MERGE_FILES_var; // if any, don't play at all, just merge these stats files and print the results
+int WORKERS_var = 0; // if nonzero, play the games in this many separate worker processes, see MS_workers.h
+char * WORKER_BLOCK_var = NULL; // set with -asworker: I am one of those workers, and this is the supervisor's shared block...
+int WORKER_SLOT_var = -1; // ...this is my slot in it...
+int WORKER_FIRST_var = 0; // ...and these are the game indices I play, [first, end)
+int WORKER_END_var = 0;
+int WORKER_TIMEOUT_var = 0; // -timeout: seconds a worker can go without finishing a game; 0 = scale it with the field size
+char * CHECKPOINT_var = NULL; // if set, save a checkpoint here every CHECKPOINT_INTERVAL_SEC seconds
+char * RESUME_var = NULL; // if set, pick up the run saved in this checkpoint instead of starting a new one
+std::atomic<bool> interrupted(false); // set by ctrl+c: finish the games in progress, don't start any more
+double TARGET_CI_var = 0.; // if nonzero, stop early once the winrate's 95% interval is this narrow (+/- this many %)
+// -paired: one of the modes that every board gets played in
+struct paired_mode {
+	int findz;
+	int gmode;
+};
+std::vector<struct paired_mode> PAIRED_var; // if any, play every board once in each of these modes and compare them
+int PIPELINE_var = 0; // if nonzero, this many threads generate the boards ahead of time for the game-playing threads
+char * SWEEP_var = NULL; // if set, play every configuration listed in this manifest file, one after another, and print a table
+
+thread_local class game mygame = game();	// init empty, will fill the field_blank later; one per game-playing thread
 class runinfo myruninfo = runinfo();		// init emtpy, will fill during input parsing
 struct run_stats myrunstats = run_stats();	// init empty, will set up histogram later
-struct game_stats mygamestats; // don't explicitly init here, its reset on each loop
+thread_local struct game_stats mygamestats; // don't explicitly init here, its reset on each loop
+thread_local struct solvercontext myctx(&mygame, &myruninfo, 0, false, NULL); // this thread's solver state, see setup_thread_game
+std::mutex print_lock; // with -threads, keeps each game's results together in the log
+class workerblock myworkerblock; // -workers: the shared stats block, from either the supervisor's or a worker's side
 
 
 
 // major structural functions (just for encapsulation, each is only called once)
 inline int parse_input_args(int margc, char *margv[]);
-inline int play_game();
+inline int play_game(struct solvercontext * ctx);
+inline struct solvercontext * setup_thread_game(int gmode, bool findz, class threadpool * tiles);
+void play_games(unsigned long long runseed, std::atomic<int> * next_game, int end_game, std::chrono::steady_clock::time_point deadline, class threadpool * tiles, struct run_stats * stats);
+inline int play_infinite_game(class chunkgame * g, long long budget, int * guesses);
+inline void run_infinite_mode(unsigned long long runseed, int first_game, int end_game);
+inline int run_merge_mode();
+inline int read_sweep_manifest(const char * path, std::vector<struct sweep_config> * out);
+inline int run_sweep_mode();
+void play_paired_games(unsigned long long runseed, std::atomic<int> * next_game, int end_game, const std::vector<std::string> * names, class threadpool * tiles, struct paired_stats * stats);
+inline int run_paired_mode(unsigned long long runseed, int first_game, int end_game, class threadpool * tiles);
+inline void play_one_game(unsigned long long runseed, int game, struct solvercontext * ctx, struct run_stats * stats, const struct boardsnapshot * ready);
+void play_ready_games(unsigned long long runseed, class boardring * ring, class threadpool * tiles, struct run_stats * stats);
+inline void run_pipeline(unsigned long long runseed, int first_game, int end_game, class threadpool * tiles, struct run_stats * stats);
+inline bool reached_target_ci(struct run_stats * stats);
+inline int run_supervisor_mode(unsigned long long runseed, int first_game, int end_game, struct run_stats * stats, std::vector<int> * crashed);
+inline int save_run_stats(const char * path, unsigned long long runseed, int next_game);
+void on_interrupt(int);
 
 
 
@@ -101,13 +157,13 @@ inline int play_game();
 inline int parse_input_args(int argc, char *argv[]) {
 
 // helptext:
-const char helptext[1700] = "MinesweeperSolver v3.0 by Brian Henson\n\
+const char helptext[5000] = "MinesweeperSolver v3.0 by Brian Henson\n\
 This program is intended to generate and play a large number of Minesweeper\n\
 games to collect win/loss info or whatever other data I feel like. It applies\n\
 single-cell and two-cell logical strategies as much as possible before\n\
 revealing any unknown cells, of course. An extensive log is generated showing\n\
 most of the stages of the solver algorithm. Each game is replayable by using\n\
-the corresponding seed in the log, for closer analysis or debugging.\n\n\
+the run seed and game # in the log, for closer analysis or debugging.\n\n\
 *Usage/args:\n\
    -h, -?:             Print this text, then exit.\n\
    -pro, -prompt:      Interactively enter various run/game settings.\n\
@@ -121,10 +177,49 @@ the corresponding seed in the log, for closer analysis or debugging.\n\n\
    -gmode:             Which guessing method to use. 0=random (fastest),\n\
 	     1=smartguess (slower but higher accuracy), 2=perfectmode (same but\n\
          highest mem usage, and has highest accuracy).\n\
-   -seed:              0=random seed, other=specify seed. Suppresses -num \n\
-         argument and plays only 1 game.\n\
+   -seed:              0=play the whole run, other=replay only this game #\n\
+         of the -runseed run. Suppresses -num argument.\n\
    -scr, -screen:      How much printed to screen. 0=minimal clutter,\n\
-         1=results for each game, 2=everything\n\n";
+         1=results for each game, 2=everything\n\
+   -infinite:          #cells. If given, stress-test the endless field\n\
+         (density from -field) until a loss or this many cells are\n\
+         revealed. This is NOT the solver: it's a simple stand-in with\n\
+         single-cell logic and lowest-ratio guessing, to exercise the\n\
+         chunked field. Its winrate says nothing about -gmode/-findz.\n\
+         Memory stays flat: chunks far behind the latest move are\n\
+         forgotten (hidden again), and count again if re-revealed.\n\
+   -tthreads:          #threads for the logic inside one game (default 1).\n\
+         Only helps on big fields; the results are identical either way.\n\
+         Can't be combined with -threads.\n\
+   -threads:           #threads, play this many games at once (default 1).\n\
+         Each game gets the same board it would get with 1 thread.\n\
+   -runseed:           Run seed that all the games come from (default\n\
+         0 = from the time). Same run seed + game # = same game.\n\
+   -shard:             K/N, play only the Kth of N equal slices of the games\n\
+         (1-based). Needs -runseed so the shards are one run together.\n\
+   -statsout:          Filename. Once done, also save the run stats there.\n\
+   -merge:             Stats files... Don't play, just combine the files\n\
+         (shards of one run) and print the results for the whole run.\n\
+   -workers:           #processes. Play the games in this many separate\n\
+         worker processes; if one crashes or hangs, its game is counted\n\
+         as an unexpected loss and a new worker carries on after it.\n\
+   -timeout:           #seconds. With -workers, how long one can go\n\
+         without finishing a game before it counts as hung. Default\n\
+         is 600 plus 1 per 1000 cells of the field.\n\
+   -checkpoint:        Filename. Save the progress there every so often.\n\
+         Ctrl+C also saves it (next to the log if this isn't given).\n\
+   -resume:            Checkpoint file. Carry on with the run saved in it,\n\
+         all of its settings come from the file.\n\
+   -targetci:          Percent. Stop early once the 95% interval on the\n\
+         winrate is this narrow (+/-), or after -num games at most.\n\
+   -paired:            List of modes, format= findz-gmode,findz-gmode,...\n\
+         or 'all'. Play every board once in each of these modes, then\n\
+         compare them head to head on the same boards.\n\
+   -pipeline:          #threads. Generate the boards on this many extra\n\
+         threads, ahead of the -threads that play them.\n\
+   -sweep:             Manifest file. Play every configuration listed in it\n\
+         (one per line: #x-#y-#mines or #x-#y-#%, findz, gmode, #games)\n\
+         in this one process, then print a table of all the results.\n\n";
    
 
 
@@ -169,7 +264,7 @@ the corresponding seed in the log, for closer analysis or debugging.\n\n\
 			int f = 0; // the index currently examined
 			int s = 0; // the place to store the next index
 			int indices[5];
-			while (f < bufstr.size()) {
+			while (f < (int)bufstr.size()) {
 				if (bufstr[f] == '-') { indices[s] = f; s++; }
 				f++;
 			}
@@ -297,7 +392,7 @@ the corresponding seed in the log, for closer analysis or debugging.\n\n\
 			}
 		} else if (!strncmp(argv[i], "-seed", 5)) {
 			if (argv[i + 1] != NULL) {
-				myruninfo.SPECIFY_SEED = atoi(argv[i + 1]);
+				myruninfo.SPECIFY_SEED = strtoull(argv[i + 1], NULL, 10);
 				// NOTE: if the argument at i+1 is not numeric, it simply returns 0 instead of complaining
 				myruninfo.NUM_GAMES = 1;
 				i++; continue;
@@ -314,37 +409,369 @@ the corresponding seed in the log, for closer analysis or debugging.\n\n\
 			} else {
 				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
 			}
+		} else if (!strncmp(argv[i], "-inf", 4)) {
+			if (argv[i + 1] != NULL) {
+				INFINITE_BUDGET_var = atoll(argv[i + 1]);
+				// NOTE: if the argument at i+1 is not numeric, it simply returns 0 instead of complaining
+				if (INFINITE_BUDGET_var < 1) { printf_s("ERR: infinite-mode budget must be positive\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-thr", 4)) {
+			if (argv[i + 1] != NULL) {
+				THREADS_var = atoi(argv[i + 1]);
+				// NOTE: if the argument at i+1 is not numeric, it simply returns 0 instead of complaining
+				if (THREADS_var < 1) { printf_s("ERR: -threads must be at least 1\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-tthr", 5)) {
+			if (argv[i + 1] != NULL) {
+				TILE_THREADS_var = atoi(argv[i + 1]);
+				// NOTE: if the argument at i+1 is not numeric, it simply returns 0 instead of complaining
+				if (TILE_THREADS_var < 1) { printf_s("ERR: -tthreads must be at least 1\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-runs", 5)) {
+			if (argv[i + 1] != NULL) {
+				RUNSEED_var = strtoull(argv[i + 1], NULL, 10);
+				// NOTE: if the argument at i+1 is not numeric, it simply returns 0 instead of complaining
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-shard", 6)) {
+			if (argv[i + 1] != NULL) {
+				if ((sscanf_s(argv[i + 1], "%i/%i", &SHARD_var, &NUM_SHARDS_var) != 2) || (NUM_SHARDS_var < 1) || (SHARD_var < 1) || (SHARD_var > NUM_SHARDS_var)) {
+					printf_s("ERR: shard must have format 'K/N' with 1 <= K <= N, '%s' is unacceptable\n", argv[i + 1]); return 1;
+				}
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-stats", 6)) {
+			if (argv[i + 1] != NULL) {
+				STATSOUT_var = argv[i + 1];
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-merge", 6)) {
+			// takes every arg after it up to the next -whatever
+			while ((argv[i + 1] != NULL) && (argv[i + 1][0] != '-')) {
+				MERGE_FILES_var.push_back(argv[i + 1]);
+				i++;
+			}
+			if (MERGE_FILES_var.empty()) {
+				printf_s("ERR: arg '%s' must be followed by one or more stats files!\n", argv[i]); return 1;
+			}
+			continue;
+		} else if (!strncmp(argv[i], "-work", 5)) {
+			if (argv[i + 1] != NULL) {
+				WORKERS_var = atoi(argv[i + 1]);
+				// NOTE: if the argument at i+1 is not numeric, it simply returns 0 instead of complaining
+				if (WORKERS_var < 1) { printf_s("ERR: -workers must be at least 1\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-timeout", 8)) {
+			if (argv[i + 1] != NULL) {
+				WORKER_TIMEOUT_var = atoi(argv[i + 1]);
+				// NOTE: if the argument at i+1 is not numeric, it simply returns 0 instead of complaining
+				if (WORKER_TIMEOUT_var < 1) { printf_s("ERR: -timeout must be at least 1 second\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-check", 6)) {
+			if (argv[i + 1] != NULL) {
+				CHECKPOINT_var = argv[i + 1];
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-resume", 7)) {
+			if (argv[i + 1] != NULL) {
+				RESUME_var = argv[i + 1];
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-target", 7)) {
+			if (argv[i + 1] != NULL) {
+				TARGET_CI_var = atof(argv[i + 1]); // a trailing % is fine, atof stops there
+				if (TARGET_CI_var <= 0.) { printf_s("ERR: -targetci must be a positive percentage, like 0.1\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-paired", 7)) {
+			if (argv[i + 1] != NULL) {
+				PAIRED_var.clear();
+				if (!strcmp(argv[i + 1], "all")) {
+					for (int z = 0; z < 2; z++) {
+						for (int g = 0; g < 3; g++) { struct paired_mode pm; pm.findz = z; pm.gmode = g; PAIRED_var.push_back(pm); }
+					}
+				} else {
+					char * context = NULL;
+					for (char * chunk = strtok_s(argv[i + 1], ",", &context); chunk != NULL; chunk = strtok_s(NULL, ",", &context)) {
+						struct paired_mode pm;
+						if (sscanf_s(chunk, "%i-%i", &pm.findz, &pm.gmode) != 2) {
+							printf_s("ERR: each -paired mode must have format 'findz-gmode', '%s' is unacceptable\n", chunk); return 1;
+						}
+						if ((pm.findz < 0) || (pm.findz > 1) || (pm.gmode < 0) || (pm.gmode > 2)) {
+							printf_s("ERR: -paired mode '%s': findz must be 0/1 and gmode 0/1/2\n", chunk); return 1;
+						}
+						for (int m = 0; m < (int)PAIRED_var.size(); m++) {
+							if ((PAIRED_var[m].findz == pm.findz) && (PAIRED_var[m].gmode == pm.gmode)) {
+								printf_s("ERR: -paired mode '%s' is in there twice\n", chunk); return 1;
+							}
+						}
+						PAIRED_var.push_back(pm);
+					}
+				}
+				if (PAIRED_var.size() < 2) { printf_s("ERR: -paired needs at least 2 modes to compare\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-pipe", 5)) {
+			if (argv[i + 1] != NULL) {
+				PIPELINE_var = atoi(argv[i + 1]);
+				if (PIPELINE_var < 1) { printf_s("ERR: -pipeline needs at least 1 thread\n"); return 1; }
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-sweep", 6)) {
+			if (argv[i + 1] != NULL) {
+				SWEEP_var = argv[i + 1];
+				i++; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by a value, or else omitted!\n", argv[i]); return 1;
+			}
+		} else if (!strncmp(argv[i], "-asworker", 9)) {
+			// not for people: the supervisor starts its workers with this, followed by block name, slot, first game, end game
+			if ((argv[i + 1] != NULL) && (argv[i + 2] != NULL) && (argv[i + 3] != NULL) && (argv[i + 4] != NULL)) {
+				WORKER_BLOCK_var = argv[i + 1];
+				WORKER_SLOT_var = atoi(argv[i + 2]);
+				WORKER_FIRST_var = atoi(argv[i + 3]);
+				WORKER_END_var = atoi(argv[i + 4]);
+				i += 4; continue;
+			} else {
+				printf_s("ERR: arg '%s' must be followed by 4 values\n", argv[i]); return 1;
+			}
 		} else {
 			printf_s("ERR: unknown argument '%s', print help with -h\n", argv[i]);
 			return 1;
 		}
 	}
+	if ((NUM_SHARDS_var > 1) && (RUNSEED_var == 0)) {
+		// each shard would get its own seeds from the time, and they wouldn't add up to one run
+		printf_s("ERR: -shard needs a -runseed, the same one for every shard\n"); return 1;
+	}
+	if ((TILE_THREADS_var > 1) && (THREADS_var > 1)) {
+		// the tile pool is shared, it can only run one game's rounds at a time; whole games keep the cores busy anyway
+		printf_s("ERR: -tthreads can't be combined with -threads, pick one\n"); return 1;
+	}
+	if ((myruninfo.SPECIFY_SEED != 0) && (RUNSEED_var == 0)) {
+		// the game # only means something within a run
+		printf_s("ERR: -seed needs the -runseed of the run that game came from\n"); return 1;
+	}
+	if (myruninfo.SPECIFY_SEED > INT_MAX) {
+		printf_s("ERR: -seed is a game #, %llu is more games than one run can have\n", myruninfo.SPECIFY_SEED); return 1;
+	}
+	if ((NUM_SHARDS_var > 1) && (myruninfo.SPECIFY_SEED != 0)) {
+		printf_s("ERR: -shard can't be combined with -seed, that plays only 1 game\n"); return 1;
+	}
+	if ((WORKERS_var != 0) && ((myruninfo.SPECIFY_SEED != 0) || (INFINITE_BUDGET_var != 0))) {
+		printf_s("ERR: -workers can't be combined with -seed or -infinite\n"); return 1;
+	}
+	if ((WORKER_TIMEOUT_var != 0) && (WORKERS_var == 0)) {
+		printf_s("ERR: -timeout only means something with -workers\n"); return 1;
+	}
+	if ((WORKERS_var != 0) && ((CHECKPOINT_var != NULL) || (RESUME_var != NULL))) {
+		printf_s("ERR: -workers can't be combined with -checkpoint or -resume\n"); return 1;
+	}
+	if ((TARGET_CI_var != 0.) && ((NUM_SHARDS_var > 1) || (WORKERS_var != 0))) {
+		// the rule has to see every game of the run, and these split it up
+		printf_s("ERR: -targetci can't be combined with -shard or -workers\n"); return 1;
+	}
+	if ((PIPELINE_var != 0) && ((myruninfo.SPECIFY_SEED != 0) || (INFINITE_BUDGET_var != 0) || (WORKERS_var != 0) || (CHECKPOINT_var != NULL) ||
+		(RESUME_var != NULL) || (TARGET_CI_var != 0.) || !PAIRED_var.empty() || (SWEEP_var != NULL))) {
+		printf_s("ERR: -pipeline can't be combined with -seed, -infinite, -workers, -checkpoint, -resume, -targetci, -paired or -sweep\n"); return 1;
+	}
+	if (!PAIRED_var.empty() && ((INFINITE_BUDGET_var != 0) || (NUM_SHARDS_var > 1) || (STATSOUT_var != NULL) || !MERGE_FILES_var.empty() ||
+		(WORKERS_var != 0) || (CHECKPOINT_var != NULL) || (RESUME_var != NULL) || (SWEEP_var != NULL) || (TARGET_CI_var != 0.))) {
+		printf_s("ERR: -paired can't be combined with -infinite, -shard, -statsout, -merge, -workers, -checkpoint, -resume, -sweep or -targetci\n"); return 1;
+	}
+	if ((SWEEP_var != NULL) && ((myruninfo.SPECIFY_SEED != 0) || (INFINITE_BUDGET_var != 0) || (NUM_SHARDS_var > 1) || (STATSOUT_var != NULL) ||
+		!MERGE_FILES_var.empty() || (WORKERS_var != 0) || (CHECKPOINT_var != NULL) || (RESUME_var != NULL))) {
+		printf_s("ERR: -sweep can't be combined with -seed, -infinite, -shard, -statsout, -merge, -workers, -checkpoint or -resume\n"); return 1;
+	}
+	if (!MERGE_FILES_var.empty()) { return 0; } // the field size etc come from the stats files instead
+	if (SWEEP_var != NULL) { return 0; } // each configuration sets its own
+	if (RESUME_var != NULL) { return 0; } // and these come from the checkpoint
 	myruninfo.set_gamedata(tempsizex, tempsizey, tempnummines);
 	return 0;
 }
 
 
+// play games until the shared counter runs out: each game takes the next index, so boards (and results) don't depend on
+// which thread happened to get it. uses this thread's own 'mygame' and 'mygamestats', and adds everything into 'stats'
+// with 1 thread this runs right on the main thread, exactly like the old single loop did
+// stops before game index 'end_game' (with -shard the counter starts partway through and ends before NUM_GAMES)
+// also stops taking new games at 'deadline' or on ctrl+c, so the caller can save a checkpoint once every thread is back
+void play_games(unsigned long long runseed, std::atomic<int> * next_game, int end_game, std::chrono::steady_clock::time_point deadline, class threadpool * tiles, struct run_stats * stats) {
+	struct solvercontext * ctx = setup_thread_game(GUESSING_MODE_var, FIND_EARLY_ZEROS_var, tiles);
+	// only the first time: with checkpoints this gets called again on the same stats, which must keep what they have
+	if ((int)stats->game_loss_histogram.size() != myruninfo.get_NUM_MINES()) { stats->init_histogram(myruninfo.get_NUM_MINES()); }
+
+	while (1) {
+		if (interrupted || (std::chrono::steady_clock::now() >= deadline)) { break; } // check first, so every index I take gets played
+		int game = next_game->fetch_add(1);
+		if (game >= end_game) { break; }
+		if (WORKER_SLOT_var >= 0) { myworkerblock.slot(WORKER_SLOT_var)->playing = game; } // so the supervisor knows who to blame
+
+		play_one_game(runseed, game, ctx, stats, NULL);
+
+		//printf_s("Finished game %i of %i\n", (game+1), NUM_GAMES);
+	}
+}
+// get this thread's board and solver context ready to play with the current settings, and return the context
+// both are made once per thread and then kept for every chunk (-checkpoint, -targetci) and configuration (-sweep) the thread
+// plays, so their memory stays allocated; the board is only re-init'd if the field size changed
+inline struct solvercontext * setup_thread_game(int gmode, bool findz, class threadpool * tiles) {
+	int x = myruninfo.get_SIZEX(), y = myruninfo.get_SIZEY();
+	if (((int)mygame.field.size() != (x + 2) * (y + 2)) || (mygame.stride != x + 2)) { mygame.init(x, y); }
+	myctx.reset(gmode, findz, tiles);
+	return &myctx;
+}
+// set up game number 'game' of the run, play it, add it into 'stats', and log the results
+// the board gets generated here, unless the -pipeline already made it ('ready')
+inline void play_one_game(unsigned long long runseed, int game, struct solvercontext * ctx, struct run_stats * stats, const struct boardsnapshot * ready) {
+	// with several threads the replay info is logged along with the results instead, so the two stay together
+	if ((THREADS_var == 1) && (myruninfo.SPECIFY_SEED == 0)) { myprintfn(myruninfo.SCREEN + 1, "Game %i: replay it with -runseed %llu -seed %i\n", game + 1, runseed, game + 1); }
+	// status tracker for impatient people
+	printf_s("Beginning game %i of %i\n", (game + 1), myruninfo.NUM_GAMES);
+
+	// reset stat-tracking variables
+	mygamestats = game_stats();
+
+	// reset everything and generate new field (or take the ready one), count how many 8-cells in the new field
+	if (ready == NULL) {
+		mygame.rng.seed(runseed, game);
+		stats->games_with_eights += mygame.reset_for_game();
+	} else {
+		stats->games_with_eights += mygame.reset_for_game(ready);
+	}
+
+	// play a game, capture the return value
+	int r = play_game(ctx);
+
+	stats->absorb_game(r, &mygamestats, mygame.get_mines_remaining(), myruninfo.get_NUM_MINES());
+	if (WORKER_SLOT_var >= 0) { myworkerblock.publish(WORKER_SLOT_var, stats, game + 1); } // this game is safe now
+
+	// print/log single-game results (also to console if #debug)
+	{
+		std::lock_guard<std::mutex> guard(print_lock); // one game's block of lines at a time
+		if ((THREADS_var != 1) && (myruninfo.SPECIFY_SEED == 0)) { myprintfn(myruninfo.SCREEN + 1, "Game %i: replay it with -runseed %llu -seed %i\n", game + 1, runseed, game + 1); }
+		mygamestats.print_gamestats(myruninfo.SCREEN + 1, &mygame, &myruninfo);
+	}
+}
+// -pipeline consumer: like play_games, but the boards come out of the ring already generated, until the producers are
+// done and the ring is empty. the board is copied out so the slot goes straight back to the producers
+void play_ready_games(unsigned long long runseed, class boardring * ring, class threadpool * tiles, struct run_stats * stats) {
+	struct solvercontext * ctx = setup_thread_game(GUESSING_MODE_var, FIND_EARLY_ZEROS_var, tiles);
+	if ((int)stats->game_loss_histogram.size() != myruninfo.get_NUM_MINES()) { stats->init_histogram(myruninfo.get_NUM_MINES()); }
+	struct boardsnapshot snap;
+
+	while (1) {
+		struct ringslot * s = ring->try_pop();
+		if (s == NULL) {
+			// nothing ready: either the producers are behind, or they're finished (and then one last look, in case the
+			// last board went in between my try_pop and them finishing)
+			if (ring->producing.load(std::memory_order_acquire) != 0) { std::this_thread::yield(); continue; }
+			s = ring->try_pop();
+			if (s == NULL) { break; }
+		}
+		int game = s->game;
+		snap = s->snap; // same size every time, so this reuses my memory
+		ring->end_pop(s);
+		play_one_game(runseed, game, ctx, stats, &snap);
+	}
+}
+
+
+// -paired: like play_games, but each board gets played once in every mode before moving on to the next one
+// the board is generated once and snapshotted, and each mode after the first starts from the snapshot, so every mode sees
+// exactly the same mines and the same random numbers; each mode has its own solver context (the settings live in there)
+void play_paired_games(unsigned long long runseed, std::atomic<int> * next_game, int end_game, const std::vector<std::string> * names, class threadpool * tiles, struct paired_stats * stats) {
+	mygame.init(myruninfo.get_SIZEX(), myruninfo.get_SIZEY());
+	std::deque<struct solvercontext> ctx;
+	for (int m = 0; m < (int)PAIRED_var.size(); m++) { ctx.emplace_back(&mygame, &myruninfo, PAIRED_var[m].gmode, bool(PAIRED_var[m].findz), tiles); }
+	struct boardsnapshot snap;
+	std::vector<int> won(PAIRED_var.size());
+	std::vector<double> ms(PAIRED_var.size());
+
+	while (1) {
+		int game = next_game->fetch_add(1);
+		if (game >= end_game) { break; }
+		if ((THREADS_var == 1) && (myruninfo.SPECIFY_SEED == 0)) { myprintfn(myruninfo.SCREEN + 1, "Game %i: replay it with -runseed %llu -seed %i\n", game + 1, runseed, game + 1); }
+		mygame.rng.seed(runseed, game);
+		printf_s("Beginning game %i of %i\n", (game + 1), myruninfo.NUM_GAMES);
+
+		int eights = mygame.reset_for_game();
+		mygame.save_board(&snap);
+		for (int m = 0; m < (int)PAIRED_var.size(); m++) {
+			if (m != 0) { mygame.reset_for_game(&snap); } // back to the start of the same board
+			mygamestats = game_stats();
+			std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+			int r = play_game(&ctx[m]);
+			ms[m] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+			won[m] = (r == 1);
+			stats->mode[m].games_with_eights += eights;
+			stats->mode[m].absorb_game(r, &mygamestats, mygame.get_mines_remaining(), myruninfo.get_NUM_MINES());
+			{
+				std::lock_guard<std::mutex> guard(print_lock);
+				if ((THREADS_var != 1) && (myruninfo.SPECIFY_SEED == 0)) { myprintfn(myruninfo.SCREEN + 1, "Game %i: replay it with -runseed %llu -seed %i\n", game + 1, runseed, game + 1); }
+				myprintfn(myruninfo.SCREEN + 1, "Mode: %s\n", (*names)[m].c_str());
+				mygamestats.print_gamestats(myruninfo.SCREEN + 1, &mygame, &myruninfo);
+			}
+		}
+		stats->absorb_board(won, ms);
+	}
+}
+
+
 // play one game with the field and zerolist as they currently are
 // this way it's easier to lose from anywhere, without breaking out of loops
 // return 1 = win, return 0 = loss, return -1 = unexpected loss
-inline int play_game() {
+inline int play_game(struct solvercontext * ctx) {
 	int r; // holds return value of any 'reveal' calls
 	int consecutiveguesses = 0; // how many consecutive guesses
 	char buffer[8];
+	thread_local static std::vector<class cell *> round; // cells to look at this pass, reused so it doesn't reallocate
+	thread_local static std::vector<char> candidate; // tiled logic: which cells of 'round' could act, as of the start of the pass
 
 	 // reveal one cell (chosen at random or guaranteed to succeed)
-	if (!FIND_EARLY_ZEROS_var) {
+	if (!ctx->find_early_zeros) {
 		// reveal a random cell (game loss is possible!)
 		mygamestats.luck_value_mult *= (1. - (float(myruninfo.get_NUM_MINES()) / float(mygame.unklist.size())));
 		mygamestats.luck_value_sum += (1. - (float(myruninfo.get_NUM_MINES()) / float(mygame.unklist.size())));
-		r = mygame.reveal(rand_from_list(&mygame.unklist));
+		r = mygame.reveal(rand_from_list(&mygame.unklist, &mygame.rng));
 		if (r == -1) { return 0; } // no need to log it, first-move loss when random-hunting is a handled situation
 		// if going to use smartguess, just pretend that the first guess was a smartguess
-		if(GUESSING_MODE_var != 0) { mygamestats.trans_map = "^ "; } else { mygamestats.trans_map = "r "; }
+		if(ctx->guessing_mode != 0) { mygamestats.trans_map = "^ "; } else { mygamestats.trans_map = "r "; }
 		// accumulate into luck value
 	} else {
 		// reveal a cell from the zerolist... game loss probably not possible, but whatever
-		r = mygame.reveal(rand_from_list(&mygame.zerolist));
+		r = mygame.reveal(rand_from_list(&mygame.zerolist, &mygame.rng));
 		if (r == -1) {
 			myprintfn(2, "ERR: Unexpected loss during initial zerolist reveal, must investigate!!\n");
 			return -1;
@@ -363,7 +790,7 @@ inline int play_game() {
 		int numactions = 0; // how many actions have been taken during this STAGE
 
 		// if # of mines remaining = # of unknown cells remaining, flag them and win!
-		if (mygame.get_mines_remaining() == mygame.unklist.size()) {
+		if ((int)mygame.get_mines_remaining() == mygame.unklist.size()) {
 			numactions = mygame.get_mines_remaining();
 			while(!mygame.unklist.empty()) {
 				r = mygame.set_flag(mygame.unklist.front());
@@ -381,13 +808,19 @@ inline int play_game() {
 		// begin single-cell logic loop
 		while(1) {
 			action = 0;
-			for (int y = 0; y < myruninfo.get_SIZEY(); y++) { for (int x = 0; x < myruninfo.get_SIZEX(); x++) { // iterate over each cell
-				class cell * me = &mygame.field[x][y];
+			// only look at the cells next to something that was revealed or flagged since the last pass, not the whole field
+			// cells further along that something in this pass changes get looked at in this pass too, like the full-field scans did
+			mygame.get_singlecell_round(&round);
+			bool tiled = find_round_candidates(ctx, round, singlecell_can_act, &candidate);
+			int next = 0, k = 0;
+			for (class cell * me = mygame.next_in_round(round, &next, &k); me != NULL; me = mygame.next_in_round(round, &next, &k)) {
 				if (me->get_status() != VISIBLE) { continue; } // SKIP
+				// on a big round, skip cells that had nothing to do at the start of the pass if nothing near them has changed since
+				if (tiled && (k >= 0) && !candidate[k] && !mygame.singlecell_changed_near(me)) { continue; }
 
 				// don't need to calculate 'effective' because it is handled every time a flag is placed
 				// therefore effective values are already correct
-				r = strat_singlecell(me, &action);
+				r = strat_singlecell(ctx, me, &action);
 				if (r == 1) {
 					// if game is won, handle trans_map and return!
 					sprintf_s(buffer, "s%i ", (numactions + action));
@@ -395,7 +828,7 @@ inline int play_game() {
 					return 1;
 				} else if (r == -1) { return -1; }// unexpected game loss, should be impossible!
 
-			}}
+			}
 
 			if (action != 0) {	// if something happened, then accumulate and don't break
 				numactions += action;
@@ -423,16 +856,22 @@ inline int play_game() {
 		while (1) {
 			action = 0; 
 			//clearlist.clear(); flaglist.clear();
-			for (int y = 0; y < myruninfo.get_SIZEY(); y++) { for (int x = 0; x < myruninfo.get_SIZEX(); x++) {// iterate over each cell
-				class cell * me = &mygame.field[x][y];
-				if ((me->get_status() != VISIBLE) || (me->get_effective() == 0)) { continue; } // SKIP
+			// only look at the cells near something that was revealed or flagged since the last pass, not the whole field
+			// anything this pass changes is looked at later in this pass if it's further along, and goes on the worklist for
+			// the NEXT pass either way, same as the old full-field passes
+			mygame.get_twocell_round(&round);
+			bool tiled = find_round_candidates(ctx, round, twocell_can_act, &candidate);
+			int next = 0, k = 0;
+			for (class cell * me = mygame.next_in_round(round, &next, &k); me != NULL; me = mygame.next_in_round(round, &next, &k)) {
+				if ((me->get_status() != VISIBLE) || (mygame.view.effective_of(me) == 0)) { continue; } // SKIP
+				if (tiled && (k >= 0) && !candidate[k] && !mygame.twocell_changed_near(me)) { continue; } // same as single-cell
 				
 				// strategy 3: 121-cross
-				r = strat_121_cross(me, &mygamestats, &action);
+				r = strat_121_cross(ctx, me, &mygamestats, &action);
 				if (r == -1) { return -1; } // unexpected game loss, should be impossible!
 
 				// strategy 4: nonoverlap-flag
-				r = strat_nonoverlap_flag(me, &mygamestats, &action);
+				r = strat_nonoverlap_flag(ctx, me, &mygamestats, &action);
 				if (r == 1) {// game won!
 					sprintf_s(buffer, "m%i ", (numactions + action));
 					mygamestats.trans_map += buffer;
@@ -440,9 +879,9 @@ inline int play_game() {
 				}
 
 				// strategy 5: nonoverlap-safe
-				r = strat_nonoverlap_safe(me, &mygamestats, &action);
+				r = strat_nonoverlap_safe(ctx, me, &mygamestats, &action);
 				if (r == -1) { return -1; } // unexpected game loss, should be impossible!
-			}}
+			}
 						
 			if (action != 0) {
 				numactions += action;
@@ -503,19 +942,19 @@ inline int play_game() {
 			// actually guess, one of 5 endpoints...
 			// To win when guessing, if every guess is successful, it will reveal information that the SC/MC
 			// logic will use to place the final flags. So, the only way to win is by revealing the right safe places.
-			if (FIND_EARLY_ZEROS_var && mygame.zerolist.size() && (mygame.get_mines_remaining() == myruninfo.get_NUM_MINES())) {
+			if (ctx->find_early_zeros && mygame.zerolist.size() && ((int)mygame.get_mines_remaining() == myruninfo.get_NUM_MINES())) {
 				// option A: reveal one cell from the zerolist... game loss probably not possible, but whatever
-				r = mygame.reveal(rand_from_list(&mygame.zerolist));
+				r = mygame.reveal(rand_from_list(&mygame.zerolist, &mygame.rng));
 				if (r == -1) {
 					myprintfn(2, "ERR: Unexpected loss during hunting zerolist reveal, must investigate!!\n");
 					winorlose = -1;
 				}
 				trans_map_char = 'z'; isaguess = true;
-			} else if(GUESSING_MODE_var == 0) {
+			} else if(ctx->guessing_mode == 0) {
 				// option B: random-guess
 				mygamestats.luck_value_mult *= (1. - (float(mygame.get_mines_remaining()) / float(mygame.unklist.size())));
 				mygamestats.luck_value_sum += (1. - (float(mygame.get_mines_remaining()) / float(mygame.unklist.size())));
-				r = mygame.reveal(rand_from_list(&mygame.unklist));
+				r = mygame.reveal(rand_from_list(&mygame.unklist, &mygame.rng));
 				if (r == -1) {
 					winorlose = 0; // normal loss
 				}
@@ -525,7 +964,7 @@ inline int play_game() {
 				// note: any clearing/flagging is done inside smartguess, only returns the gamestate after and a flag to identify what logic was used
 
 				int modeflag = 0; // 0=guess, 1=multicell, 2=endsolver
-				r = smartguess(&mygamestats, &trans_map_val, &modeflag);
+				r = smartguess(ctx, &mygamestats, &trans_map_val, &modeflag);
 				// if win, return 1; if lose, return as EXPECTED loss 0 or unexpected loss -1
 				// return->stored		1->1		-1->0		-2->-1		0->not stored, continue
 				if (r == 1) { winorlose = 1; } else if (r < 0) { winorlose = r + 1; }
@@ -566,6 +1005,516 @@ inline int play_game() {
 }
 
 
+// play one stress-test game on the endless field, starting from 0,0 (which is always a zero)
+// this is NOT the solver (the strategies in MS_solver.cpp all work on a 'game', not on chunks), just enough of a player to
+// push the chunked field around: single-cell logic off a worklist, and when that runs dry it guesses next to the frontier
+// cell with the lowest effective/unknown ratio. so the results measure the field code, not the solver's winrate
+// return 1 = reached the budget, return 0 = loss, return -1 = unexpected loss
+inline int play_infinite_game(class chunkgame * g, long long budget, int * guesses) {
+	// kept between games so they don't have to be reallocated, one set per thread
+	thread_local std::vector<std::pair<int, int>> work; // visible cells whose neighborhood changed
+	thread_local std::unordered_set<uint64_t> frontier; // visible cells that might still touch an unknown, for guessing
+	work.clear();
+	frontier.clear();
+	*guesses = 0;
+	long long forgets = 0; // g->forgets as of the last time work/frontier were cleaned up
+
+	int r = g->reveal(0, 0, budget);
+	if (r == -1) { myprintfn(2, "ERR: Unexpected loss during infinite-mode opening, must investigate!!\n"); return -1; }
+
+	while (g->revealed < budget) {
+		// the board forgot the chunks far behind the latest move, so drop every cell of theirs that I'm still holding
+		if (g->forgets != forgets) {
+			forgets = g->forgets;
+			int keep = 0;
+			for (int i = 0; i < (int)work.size(); i++) {
+				if (g->get_status(work[i].first, work[i].second) == VISIBLE) { work[keep++] = work[i]; }
+			}
+			work.resize(keep);
+			for (std::unordered_set<uint64_t>::iterator it = frontier.begin(); it != frontier.end(); ) {
+				if (g->get_status((int)(uint32_t)(*it >> 32), (int)(uint32_t)(*it)) != VISIBLE) { it = frontier.erase(it); }
+				else { it++; }
+			}
+		}
+		// anything that changed means its visible neighbors (and itself) have something new to think about
+		for (int i = 0; i < (int)g->changed.size(); i++) {
+			for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+				int x = g->changed[i].first + a; int y = g->changed[i].second + b;
+				if (g->get_status(x, y) != VISIBLE) { continue; }
+				if (g->count_unknown_around(x, y) == 0) { continue; } // nothing left to decide or guess next to
+				work.push_back(std::pair<int, int>(x, y));
+				frontier.insert(((uint64_t)(uint32_t)x << 32) | (uint64_t)(uint32_t)y);
+			}}
+		}
+		g->changed.clear();
+		// my own structures count toward the memory the report shows
+		g->track_peak(hash_table_bytes(frontier) + (work.capacity() * sizeof(work[0])));
+
+		if (!work.empty()) {
+			// single-cell logic, same two rules as strat_singlecell
+			int x = work.back().first; int y = work.back().second;
+			work.pop_back();
+			int u = g->count_unknown_around(x, y);
+			if (u == 0) { continue; }
+			int e = g->get_effective(x, y);
+			if ((e != 0) && (e != u)) { continue; }
+			for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+				if (g->get_status(x + a, y + b) != UNKNOWN) { continue; }
+				if (e == 0) {
+					if (g->reveal(x + a, y + b, budget) == -1) {
+						myprintfn(2, "ERR: Unexpected loss during infinite-mode reveal, must investigate!!\n"); assert(0); return -1;
+					}
+				} else if (g->set_flag(x + a, y + b) == 2) {
+					myprintfn(2, "ERR: Unexpected wrong flag during infinite-mode logic, must investigate!!\n"); assert(0); return -1;
+				}
+			}}
+			continue;
+		}
+
+		// logic is stuck: guess. find the frontier cell with the lowest effective/unknown ratio (ties go to the
+		// lowest y, then lowest x, so it doesn't depend on hash order), and reveal its first unknown neighbor
+		int bx = 0, by = 0; float bestrisk = 2.;
+		for (std::unordered_set<uint64_t>::iterator it = frontier.begin(); it != frontier.end(); ) {
+			int x = (int)(uint32_t)(*it >> 32); int y = (int)(uint32_t)(*it);
+			int u = g->count_unknown_around(x, y);
+			if (u == 0) { it = frontier.erase(it); continue; } // all done, never needs looking at again
+			float risk = float(g->get_effective(x, y)) / float(u);
+			if ((risk < bestrisk) || ((risk == bestrisk) && ((y < by) || ((y == by) && (x < bx))))) {
+				bestrisk = risk; bx = x; by = y;
+			}
+			it++;
+		}
+		if (bestrisk == 2.) { // should never happen, the frontier around the latest move is always inside the window
+			myprintfn(2, "ERR: Ran out of frontier during infinite-mode guessing, must investigate!!\n"); assert(0); return -1;
+		}
+		(*guesses)++;
+		for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+			if (g->get_status(bx + a, by + b) != UNKNOWN) { continue; }
+			if (g->reveal(bx + a, by + b, budget) == -1) { return 0; } // lost on a guess
+			goto LABEL_GUESSED;
+		}}
+	LABEL_GUESSED:
+		continue;
+	}
+	return 1;
+}
+
+// the whole run for -infinite: games [first_game, end_game), each its own stream of the run seed, then print the totals
+// these are stress-test games played by play_infinite_game's stand-in, and the report says so
+inline void run_infinite_mode(unsigned long long runseed, int first_game, int end_game) {
+	class chunkgame g;
+	double density = double(myruninfo.get_NUM_MINES()) / double(myruninfo.get_SIZEX() * myruninfo.get_SIZEY());
+	double ngames = double(end_game - first_game);
+	myprintfn(2, "Infinite-field stress test: density %.4f, budget %lld cells per game, %ix%i chunks\n", density, INFINITE_BUDGET_var, CHUNK_SIZE, CHUNK_SIZE);
+	myprintfn(2, "NOTE: played by a simple single-cell player, not the solver; -gmode and -findz don't apply\n");
+	long long total_revealed = 0, total_guesses = 0, chunks_generated = 0, forgets = 0;
+	size_t bytes_peak = 0;
+	int reached = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int game = first_game; game < end_game; game++) {
+		myprintfn(myruninfo.SCREEN + 1, "Game %i: replay it with -runseed %llu -seed %i\n", game + 1, runseed, game + 1);
+		printf_s("Beginning game %i of %i\n", (game + 1), myruninfo.NUM_GAMES);
+		g.reset_for_game(runseed, game, density);
+		int guesses = 0;
+		int r = play_infinite_game(&g, INFINITE_BUDGET_var, &guesses);
+		myprintfn(myruninfo.SCREEN + 1, "Game %i: %s after %lld cells revealed, %lld flags, %i guesses, peak mem %.1f KB\n",
+			game + 1, (r == 1) ? "reached budget" : ((r == 0) ? "lost" : "UNEXPECTED LOSS"), g.revealed, g.flags, guesses, double(g.bytes_peak) / 1024.);
+		reached += (r == 1);
+		total_revealed += g.revealed;
+		total_guesses += guesses;
+		chunks_generated += g.chunks_generated;
+		forgets += g.forgets;
+		if (g.bytes_peak > bytes_peak) { bytes_peak = g.bytes_peak; }
+	}
+	double elapsed_sec = double(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()) / 1000.;
+	myprintfn(2, "\nInfinite-field stress test results (simple single-cell player, not the solver):\n");
+	myprintfn(2, "    Games that reached the budget:       %6i     %5.1f%%\n", reached, 100. * double(reached) / ngames);
+	myprintfn(2, "    Average cells revealed per game:     %9.1f\n", double(total_revealed) / ngames);
+	myprintfn(2, "    Average guesses per game:            %9.1f\n", double(total_guesses) / ngames);
+	myprintfn(2, "    Chunks generated per game:           %9.1f\n", double(chunks_generated) / ngames);
+	myprintfn(2, "    Chunks forgotten (outside window):   %9.1f times per game\n", double(forgets) / ngames);
+	myprintfn(2, "    Peak memory (board and player):      %9.1f KB\n", double(bytes_peak) / 1024.);
+	myprintfn(2, "    Cells revealed per second:           %9.0f\n", (elapsed_sec > 0.) ? (double(total_revealed) / elapsed_sec) : 0.);
+}
+
+
+// -merge: read every stats file, check they're all shards of the same run, add them up and print the results like a normal run
+// return 0 on success, 1 if any file is missing/bad/doesn't belong
+inline int run_merge_mode() {
+	struct run_stats total;
+	struct stats_header first;
+	std::vector<int> seen; // how many times each shard showed up
+	for (int f = 0; f < (int)MERGE_FILES_var.size(); f++) {
+		struct run_stats one;
+		struct stats_header hdr;
+		if (one.read_file(MERGE_FILES_var[f], &hdr)) { return 1; }
+		myprintfn(2, "Read '%s': shard %i of %i, %i games, run seed %llu\n", MERGE_FILES_var[f], hdr.shard, hdr.num_shards, one.games_total, hdr.runseed);
+		if (f == 0) {
+			first = hdr;
+			seen.assign(hdr.num_shards, 0);
+			total.init_histogram(hdr.num_mines);
+		} else if ((hdr.sizex != first.sizex) || (hdr.sizey != first.sizey) || (hdr.num_mines != first.num_mines) || (hdr.findz != first.findz) ||
+			(hdr.gmode != first.gmode) || (hdr.runseed != first.runseed) || (hdr.num_shards != first.num_shards) || (hdr.num_games != first.num_games)) {
+			myprintfn(2, "ERR: '%s' is not from the same run as '%s', can't merge them\n", MERGE_FILES_var[f], MERGE_FILES_var[0]);
+			return 1;
+		}
+		if ((hdr.shard < 1) || (hdr.shard > hdr.num_shards)) { myprintfn(2, "ERR: '%s' has a bad shard number\n", MERGE_FILES_var[f]); return 1; }
+		if (seen[hdr.shard - 1]) { myprintfn(2, "ERR: shard %i is in there twice, '%s'\n", hdr.shard, MERGE_FILES_var[f]); return 1; }
+		seen[hdr.shard - 1]++;
+		int shard_end = int((long long)hdr.num_games * hdr.shard / hdr.num_shards);
+		if (hdr.next_game < shard_end) {
+			myprintfn(2, "WARNING: '%s' is a checkpoint, only games up to %i of that shard are in it\n", MERGE_FILES_var[f], hdr.next_game);
+		}
+		total.merge(one);
+	}
+	for (int s = 0; s < (int)seen.size(); s++) {
+		if (!seen[s]) { myprintfn(2, "WARNING: shard %i of %i is missing, results only cover the shards given\n", s + 1, first.num_shards); }
+	}
+
+	// print_final_stats gets the field size from myruninfo, so make it look like the run that made the files
+	myruninfo.set_gamedata(first.sizex, first.sizey, first.num_mines);
+	myruninfo.NUM_GAMES = total.games_total;
+	total.print_final_stats(&myruninfo, bool(first.findz), first.gmode);
+	return 0;
+}
+
+
+// one line of a -sweep manifest
+struct sweep_config {
+	int sizex, sizey, num_mines;
+	int findz, gmode;
+	int num_games;
+};
+// read a -sweep manifest: one configuration per line, "#x-#y-#mines findz gmode #games", where #mines can instead be a
+// density like "20%" and #games can be left off to use -num. blank lines and lines starting with # are skipped
+// return 0 on success, 1 if the file is missing or any line is bad
+inline int read_sweep_manifest(const char * path, std::vector<struct sweep_config> * out) {
+	FILE * fp = NULL;
+	fopen_s(&fp, path, "r");
+	if (!fp) { myprintfn(2, "ERR: couldn't open sweep manifest '%s'\n", path); return 1; }
+	char line[256];
+	int lineno = 0;
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		lineno++;
+		char * context = NULL;
+		char * tok[4] = { NULL, NULL, NULL, NULL };
+		int ntok = 0;
+		for (char * t = strtok_s(line, " \t\r\n", &context); t != NULL; t = strtok_s(NULL, " \t\r\n", &context)) {
+			if (ntok == 4) { ntok++; break; }
+			tok[ntok++] = t;
+		}
+		if ((ntok == 0) || (tok[0][0] == '#')) { continue; }
+		if ((ntok < 3) || (ntok > 4)) {
+			myprintfn(2, "ERR: '%s' line %i: need '#x-#y-#mines findz gmode [#games]'\n", path, lineno); fclose(fp); return 1;
+		}
+		struct sweep_config c;
+		char * fcontext = NULL;
+		char * x = strtok_s(tok[0], "-", &fcontext);
+		char * y = strtok_s(NULL, "-", &fcontext);
+		char * m = strtok_s(NULL, "-", &fcontext);
+		if ((x == NULL) || (y == NULL) || (m == NULL)) {
+			myprintfn(2, "ERR: '%s' line %i: field must have format '#-#-#' or '#-#-#%%'\n", path, lineno); fclose(fp); return 1;
+		}
+		c.sizex = atoi(x); c.sizey = atoi(y);
+		if (m[strlen(m) - 1] == '%') {
+			c.num_mines = int((double(c.sizex) * double(c.sizey) * atof(m) / 100.) + 0.5); // density, rounded to the nearest mine
+		} else {
+			c.num_mines = atoi(m);
+		}
+		c.findz = atoi(tok[1]);
+		c.gmode = atoi(tok[2]);
+		c.num_games = (ntok == 4) ? atoi(tok[3]) : myruninfo.NUM_GAMES;
+		// same limits as the command line
+		if ((c.sizex < 1) || (c.sizey < 1) || (c.num_mines < 1) || (c.num_mines > (c.sizex * c.sizey))) {
+			myprintfn(2, "ERR: '%s' line %i: bad field size or number of mines\n", path, lineno); fclose(fp); return 1;
+		}
+		if ((c.findz < 0) || (c.findz > 1) || (c.gmode < 0) || (c.gmode > 2) || (c.num_games < 1)) {
+			myprintfn(2, "ERR: '%s' line %i: findz must be 0/1, gmode 0/1/2, and #games at least 1\n", path, lineno); fclose(fp); return 1;
+		}
+		out->push_back(c);
+	}
+	fclose(fp);
+	if (out->empty()) { myprintfn(2, "ERR: sweep manifest '%s' has no configurations in it\n", path); return 1; }
+	return 0;
+}
+// -sweep: play every configuration in the manifest, one after another, each spread across the -threads
+// the threads live in one pool for the whole sweep, so each one keeps its own 'mygame' and the next configuration
+// reuses its memory instead of starting over; every configuration uses the same run seed, so it's all repeatable with -runseed
+// return 0 on success, 1 if the manifest is bad
+inline int run_sweep_mode() {
+	std::vector<struct sweep_config> configs;
+	if (read_sweep_manifest(SWEEP_var, &configs)) { return 1; }
+	unsigned long long runseed = RUNSEED_var;
+	if (runseed == 0) {
+		runseed = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch()
+			).count();
+	}
+	if (THREADS_var < 1) { THREADS_var = 1; }
+	class threadpool tilepool; // -tthreads, for the logic inside the one game at a time (never with -threads)
+	tilepool.init(TILE_THREADS_var);
+	class threadpool * tiles = (THREADS_var == 1) ? &tilepool : NULL;
+	class threadpool gamepool; // the game-playing threads, shared by every configuration
+	gamepool.init(THREADS_var);
+	myprintfn(2, "Sweeping %i configurations from '%s' on %i threads, run seed %llu\n", (int)configs.size(), SWEEP_var, THREADS_var, runseed);
+	fflush(myruninfo.logfile);
+
+	std::vector<struct run_stats> results(configs.size());
+	std::vector<long long> took_ms(configs.size());
+	for (int c = 0; c < (int)configs.size(); c++) {
+		// the game-playing threads pick these up at the start of each chunk, so they change between configurations, never during one
+		myruninfo.change_gamedata(configs[c].sizex, configs[c].sizey, configs[c].num_mines);
+		myruninfo.NUM_GAMES = configs[c].num_games;
+		FIND_EARLY_ZEROS_var = bool(configs[c].findz);
+		GUESSING_MODE_var = configs[c].gmode;
+
+		results[c] = run_stats(); // starts the clock for this configuration
+		results[c].init_histogram(configs[c].num_mines);
+		std::atomic<int> next_game(0);
+		while (next_game < configs[c].num_games) {
+			// with -targetci, stop at the first check where the winrate is known well enough
+			int chunk_end = configs[c].num_games;
+			if (TARGET_CI_var != 0.) { chunk_end = (std::min)(chunk_end, ((next_game / TARGET_CI_CHECK_GAMES) + 1) * TARGET_CI_CHECK_GAMES); }
+			std::vector<struct run_stats> perthread(THREADS_var);
+			gamepool.run(THREADS_var, [&](int t) {
+				play_games(runseed, &next_game, chunk_end, (std::chrono::steady_clock::time_point::max)(), tiles, &perthread[t]);
+			});
+			for (int t = 0; t < THREADS_var; t++) { results[c].merge(perthread[t]); }
+			next_game = chunk_end;
+			if (reached_target_ci(&results[c])) { break; }
+		}
+		took_ms[c] = results[c].elapsed_ms();
+		myprintfn(2, "Configuration %i of %i: %i/%i/%i findz %i gmode %i, won %i of %i games\n", c + 1, (int)configs.size(), configs[c].sizex, configs[c].sizey,
+			configs[c].num_mines, configs[c].findz, configs[c].gmode, results[c].games_won, results[c].games_total);
+		fflush(myruninfo.logfile);
+	}
+
+	// one table for the whole sweep, whitespace-separated so it's easy to pull into a spreadsheet
+	myprintfn(2, "\nSweep results, run seed %llu (time is wall-clock for all the threads together):\n", runseed);
+	myprintfn(2, "    X     Y   mines  density  findz  gmode      games        won   winrate  95%% +/-    ms/game\n");
+	for (int c = 0; c < (int)configs.size(); c++) {
+		struct run_stats * r = &results[c];
+		double lo, hi;
+		r->winrate_interval(&lo, &hi);
+		myprintfn(2, "%5i %5i %7i %7.3f%% %6i %6i %10i %10i %8.3f%% %8.3f%% %10.4f\n", configs[c].sizex, configs[c].sizey, configs[c].num_mines,
+			100. * double(configs[c].num_mines) / (double(configs[c].sizex) * double(configs[c].sizey)), configs[c].findz, configs[c].gmode,
+			r->games_total, r->games_won, 100. * double(r->games_won) / double(r->games_total), 50. * (hi - lo), double(took_ms[c]) / double(r->games_total));
+	}
+	return 0;
+}
+
+
+// -pipeline: PIPELINE_var threads generate the boards for [first_game, end_game) into a ring, and THREADS_var threads play them
+inline void run_pipeline(unsigned long long runseed, int first_game, int end_game, class threadpool * tiles, struct run_stats * stats) {
+	class boardring ring;
+	ring.init(PIPELINE_RING_SIZE);
+	ring.producing = PIPELINE_var;
+	std::atomic<int> next_board(first_game);
+	std::vector<std::thread> producers;
+	for (int p = 0; p < PIPELINE_var; p++) {
+		producers.push_back(std::thread(produce_boards, runseed, &next_board, end_game, &ring));
+	}
+	if (THREADS_var == 1) {
+		play_ready_games(runseed, &ring, tiles, stats);
+	} else {
+		std::vector<struct run_stats> perthread(THREADS_var);
+		std::vector<std::thread> workers;
+		for (int t = 0; t < THREADS_var; t++) {
+			workers.push_back(std::thread(play_ready_games, runseed, &ring, tiles, &perthread[t]));
+		}
+		for (int t = 0; t < THREADS_var; t++) {
+			workers[t].join();
+			stats->merge(perthread[t]);
+		}
+	}
+	for (int p = 0; p < PIPELINE_var; p++) { producers[p].join(); }
+}
+
+
+// -paired: play every board in [first_game, end_game) in all the PAIRED_var modes, on -threads threads, and print the comparison
+// return 0 (nothing in here can fail, but it matches the other modes)
+inline int run_paired_mode(unsigned long long runseed, int first_game, int end_game, class threadpool * tiles) {
+	std::vector<std::string> names;
+	for (int m = 0; m < (int)PAIRED_var.size(); m++) {
+		names.push_back("findz " + std::to_string(PAIRED_var[m].findz) + " gmode " + std::to_string(PAIRED_var[m].gmode));
+	}
+	myprintfn(2, "Playing every board in %i modes:", (int)PAIRED_var.size());
+	for (int m = 0; m < (int)names.size(); m++) { myprintfn(2, "%s %s", (m ? "," : ""), names[m].c_str()); }
+	myprintfn(2, "\n");
+	fflush(myruninfo.logfile);
+
+	struct paired_stats total;
+	total.init(PAIRED_var.size(), myruninfo.get_NUM_MINES());
+	std::atomic<int> next_game(first_game);
+	if (THREADS_var == 1) {
+		play_paired_games(runseed, &next_game, end_game, &names, tiles, &total);
+	} else {
+		std::vector<struct paired_stats> perthread(THREADS_var);
+		std::vector<std::thread> workers;
+		for (int t = 0; t < THREADS_var; t++) {
+			perthread[t].init(PAIRED_var.size(), myruninfo.get_NUM_MINES());
+			workers.push_back(std::thread(play_paired_games, runseed, &next_game, end_game, &names, tiles, &perthread[t]));
+		}
+		for (int t = 0; t < THREADS_var; t++) {
+			workers[t].join();
+			total.merge(perthread[t]);
+		}
+	}
+	total.print(names);
+	return 0;
+}
+
+
+// -targetci: is the winrate's 95% interval narrow enough to stop? always false without -targetci
+inline bool reached_target_ci(struct run_stats * stats) {
+	if (TARGET_CI_var == 0.) { return false; }
+	double lo, hi;
+	stats->winrate_interval(&lo, &hi);
+	return (50. * (hi - lo)) <= TARGET_CI_var;
+}
+
+
+// save myrunstats along with everything needed to -merge or -resume them: the settings, run seed, and next game to play
+// written to a temp file and then moved over the old one, so a crash halfway through never leaves a broken checkpoint
+// return 0 on success, 1 on failure
+inline int save_run_stats(const char * path, unsigned long long runseed, int next_game) {
+	struct stats_header hdr;
+	hdr.sizex = myruninfo.get_SIZEX(); hdr.sizey = myruninfo.get_SIZEY(); hdr.num_mines = myruninfo.get_NUM_MINES();
+	hdr.findz = FIND_EARLY_ZEROS_var; hdr.gmode = GUESSING_MODE_var;
+	hdr.runseed = runseed;
+	hdr.shard = SHARD_var; hdr.num_shards = NUM_SHARDS_var; hdr.num_games = myruninfo.NUM_GAMES;
+	hdr.next_game = next_game;
+	std::string tmp = std::string(path) + ".tmp";
+	if (myrunstats.write_file(tmp.c_str(), &hdr)) { return 1; }
+	if (!MoveFileExA(tmp.c_str(), path, MOVEFILE_REPLACE_EXISTING)) {
+		myprintfn(2, "ERR: couldn't replace '%s' with the new save\n", path);
+		return 1;
+	}
+	return 0;
+}
+// ctrl+c: just set the flag, the games in progress finish and then the main loop saves a checkpoint
+// a second ctrl+c before that happens kills it like normal
+void on_interrupt(int) {
+	interrupted = true;
+	signal(SIGINT, SIG_DFL);
+}
+
+
+// -workers: split [first_game, end_game) into WORKERS_var ranges, start a worker process on each, and watch them
+// a worker that crashes (or goes too long without publishing a game, and gets killed) keeps everything it published; the
+// game it was on counts as an unexpected loss and goes in 'crashed', and a new worker picks up after it
+// if it died halfway thru publishing, its slot is torn, so it keeps the last good copy I read instead and redoes the rest
+// everything ends up in 'stats'; return 0, or 1 if it couldn't get going at all
+inline int run_supervisor_mode(unsigned long long runseed, int first_game, int end_game, struct run_stats * stats, std::vector<int> * crashed) {
+	if (myworkerblock.create(WORKERS_var, stats->flat_size())) { return 1; }
+	// every worker gets the same settings as me, plus its own slot and range
+	char common[300];
+	sprintf_s(common, "-field %i-%i-%i -findz %i -gmode %i -scr %i -num %i -runseed %llu -tthreads %i -asworker %s",
+		myruninfo.get_SIZEX(), myruninfo.get_SIZEY(), myruninfo.get_NUM_MINES(), int(FIND_EARLY_ZEROS_var), GUESSING_MODE_var,
+		myruninfo.SCREEN, myruninfo.NUM_GAMES, runseed, TILE_THREADS_var, myworkerblock.name());
+	// -timeout, or else scaled with the field size
+	long long timeout = WORKER_TIMEOUT_var;
+	if (timeout == 0) { timeout = WORKER_HANG_TIMEOUT + (long long)myruninfo.get_SIZEX() * myruninfo.get_SIZEY() / WORKER_HANG_CELLS_PER_SEC; }
+	myprintfn(2, "A worker that goes %lli seconds without finishing a game counts as hung\n", timeout);
+
+	struct worker {
+		HANDLE process;
+		int first, end;		// the range the current process is playing
+		bool alive;
+		long long lastseq;	// heartbeat: the slot's seq changes after every game
+		std::chrono::steady_clock::time_point lastchange; // when it last published (or was launched)
+		struct run_stats good; long long goodnext; // the last consistent copy of its slot, in case it dies mid-publish
+	};
+	std::vector<struct worker> w(WORKERS_var);
+	int alive = 0;
+	for (int k = 0; k < WORKERS_var; k++) {
+		w[k].first = first_game + int((long long)(end_game - first_game) * k / WORKERS_var);
+		w[k].end = first_game + int((long long)(end_game - first_game) * (k + 1) / WORKERS_var);
+		w[k].alive = (launch_worker(std::string(common) + " " + std::to_string(k) + " " + std::to_string(w[k].first) + " " + std::to_string(w[k].end), &w[k].process) == 0);
+		if (!w[k].alive) { return 1; }
+		w[k].lastseq = 0;
+		w[k].lastchange = std::chrono::steady_clock::now();
+		w[k].good = run_stats(); w[k].good.init_histogram(myruninfo.get_NUM_MINES()); w[k].goodnext = w[k].first;
+		alive++;
+	}
+
+	std::chrono::steady_clock::time_point lastreport = std::chrono::steady_clock::now();
+	while (alive > 0) {
+		Sleep(WORKER_POLL_MS);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		int done = stats->games_total; // for the progress report
+		for (int k = 0; k < WORKERS_var; k++) {
+			if (!w[k].alive) { continue; }
+			struct worker_slot * s = myworkerblock.slot(k);
+			long long seq = s->seq.load();
+			if (seq != w[k].lastseq) {
+				w[k].lastseq = seq; w[k].lastchange = now;
+				myworkerblock.read(k, &w[k].good, &w[k].goodnext, WORKER_READ_TRIES); // if it's always busy, keep the old copy
+			}
+			unsigned long exitcode = 0;
+			if (worker_exited(w[k].process, &exitcode)) {
+				if (s->finished.load()) {
+					// all done, collect its stats (it sets finished after its last publish, so the slot can't be torn)
+					struct run_stats part = w[k].good; long long next;
+					myworkerblock.read(k, &part, &next, 1);
+					stats->merge(part);
+					w[k].alive = false; alive--;
+					continue;
+				}
+			} else if (std::chrono::duration_cast<std::chrono::seconds>(now - w[k].lastchange).count() > timeout) {
+				kill_worker(w[k].process);
+				exitcode = 0xFFFFFFFF;
+				myprintfn(2, "WARNING: worker %i hasn't finished a game in %lli seconds, killed it\n", k, timeout);
+			} else {
+				long long next = s->next_game.load();
+				done += int(((next > w[k].first) ? next : w[k].first) - w[k].first);
+				continue; // still going
+			}
+
+			// it died partway: keep what it published, skip the game it was on, and start a new worker right after it
+			struct run_stats part; long long next;
+			long long bad = s->playing.load();
+			if (!myworkerblock.read(k, &part, &next, 1)) {
+				// torn: it died while publishing, so no game is to blame; fall back on my last good copy, and the games
+				// after that get played again (same seeds, same results)
+				myprintfn(2, "WARNING: worker %i died (exit code 0x%08lx) while publishing; redoing its games from game %i\n", k, exitcode, int(w[k].goodnext) + 1);
+				part = w[k].good; next = w[k].goodnext;
+				bad = -1;
+			}
+			stats->merge(part);
+			if (next < w[k].first) { next = w[k].first; } // never published anything
+			if (bad < next) { bad = -1; } // it was between games (the last one it was on is already published)
+			if (bad >= 0) {
+				myprintfn(2, "WARNING: worker %i died (exit code 0x%08lx) on game %i; counting it as an unexpected loss and moving on\n", k, exitcode, int(bad) + 1);
+				crashed->push_back(int(bad));
+				stats->absorb_crash();
+				next = bad + 1;
+			} else if (next == w[k].first) {
+				// died before playing anything: something is wrong with the worker itself, restarting it won't help
+				myprintfn(2, "ERR: worker %i died (exit code 0x%08lx) before playing anything, giving up on games %i to %i\n", k, exitcode, w[k].first + 1, w[k].end);
+				w[k].alive = false; alive--;
+				continue;
+			}
+			w[k].first = int(next);
+			if (w[k].first >= w[k].end) { w[k].alive = false; alive--; continue; }
+			myworkerblock.reset(k); // seq back to even, even if it died mid-publish
+			if (launch_worker(std::string(common) + " " + std::to_string(k) + " " + std::to_string(w[k].first) + " " + std::to_string(w[k].end), &w[k].process)) {
+				w[k].alive = false; alive--; continue;
+			}
+			w[k].lastseq = 0;
+			w[k].lastchange = now;
+			w[k].good = run_stats(); w[k].good.init_histogram(myruninfo.get_NUM_MINES()); w[k].goodnext = w[k].first;
+		}
+		if (std::chrono::duration_cast<std::chrono::seconds>(now - lastreport).count() >= WORKER_REPORT_SEC) {
+			printf_s("Finished %i of %i games, %i workers running\n", done, end_game - first_game, alive);
+			lastreport = now;
+		}
+	}
+	std::sort(crashed->begin(), crashed->end());
+	return 0;
+}
+
+
 // ************************************************************************************************
 int main(int argc, char *argv[]) {
 	// full-run init:
@@ -590,6 +1539,7 @@ int main(int argc, char *argv[]) {
 	strftime(&filepath[0], filepath.size(), ".\\LOGS\\minesweeper_%m-%d-%H-%M-%S", &now);
 	//filepath = ".\\LOGS\\test";
 	filepath = filepath.c_str(); // eliminate the trailing space after the null-terminator (yes, actually needed)
+	if (WORKER_SLOT_var >= 0) { filepath = filepath + "_w" + std::to_string(WORKER_SLOT_var); } // workers all start at once
 	// test if the file already exists (batch mode running really fast, maybe)
 	if (GetFileAttributes((filepath + ".log").c_str()) != INVALID_FILE_ATTRIBUTES) {
 		printf_s("File already exists, '%s', trying alts\n", (filepath + ".log").c_str());
@@ -616,124 +1566,213 @@ int main(int argc, char *argv[]) {
 	myprintfn(2, "Logfile success! Created '%s'\n\n", filepath.c_str());
 	myprintfn(2, "Beginning MinesweeperSolver version %s\n", VERSION_STRING_def);
 
+	if (!MERGE_FILES_var.empty()) {
+		// nothing to play, the results come from the files
+		int r = run_merge_mode();
+		fclose(myruninfo.logfile);
+		if (USE_END_PAUSE_var) { system("pause"); }
+		return r;
+	}
+	if (SWEEP_var != NULL) {
+		// a whole list of runs instead of just one
+		int r = run_sweep_mode();
+		fclose(myruninfo.logfile);
+		if (USE_END_PAUSE_var) { system("pause"); }
+		return r;
+	}
+
+	int first_game = 0;
+	if (RESUME_var != NULL) {
+		// everything about the run comes from the checkpoint: the settings, the run seed, and the stats so far
+		struct stats_header hdr;
+		if (myrunstats.read_file(RESUME_var, &hdr)) { fclose(myruninfo.logfile); return 1; }
+		myruninfo.set_gamedata(hdr.sizex, hdr.sizey, hdr.num_mines);
+		FIND_EARLY_ZEROS_var = bool(hdr.findz);
+		GUESSING_MODE_var = hdr.gmode;
+		RUNSEED_var = hdr.runseed;
+		SHARD_var = hdr.shard; NUM_SHARDS_var = hdr.num_shards;
+		myruninfo.NUM_GAMES = hdr.num_games;
+		first_game = hdr.next_game;
+		if (CHECKPOINT_var == NULL) { CHECKPOINT_var = RESUME_var; } // keep saving to the same file
+		myprintfn(2, "Resuming from '%s' at game %i, %i games already done\n", RESUME_var, first_game + 1, myrunstats.games_total);
+	}
+
 	// logfile header info: mostly everything from the #defines
 	myprintfn(2, "Going to play %i games, with X/Y/mines = %i/%i/%i\n", myruninfo.NUM_GAMES, myruninfo.get_SIZEX(), myruninfo.get_SIZEY(), myruninfo.get_NUM_MINES());
-	if (FIND_EARLY_ZEROS_var) {
-		myprintfn(2, "Using 'hunting' method = zero-guess (uncover only zeroes until solving gets underway)\n");
-	} else {
-		myprintfn(2, "Using 'hunting' method = human-like (can lose at any stage)\n");
+	if (PAIRED_var.empty() && (INFINITE_BUDGET_var == 0)) { // -paired lists its own modes, and -infinite doesn't use them
+		if (FIND_EARLY_ZEROS_var) {
+			myprintfn(2, "Using 'hunting' method = zero-guess (uncover only zeroes until solving gets underway)\n");
+		} else {
+			myprintfn(2, "Using 'hunting' method = human-like (can lose at any stage)\n");
+		}
+
+		if (GUESSING_MODE_var == 0) {
+			myprintfn(2, "Using 'guessing' mode = guess randomly (lower winrate but faster)\n");
+		} else if (GUESSING_MODE_var == 1) {
+			myprintfn(2, "Using 'guessing' mode = smartguess (slower but increased winrate)\n");
+		} else if (GUESSING_MODE_var == 2) {
+			myprintfn(2, "Using 'guessing' mode = perfectmode (experimental, maximum winrate)\n");
+		}
 	}
 
-	if (GUESSING_MODE_var == 0) {
-		myprintfn(2, "Using 'guessing' mode = guess randomly (lower winrate but faster)\n");
-	} else if (GUESSING_MODE_var == 1) {
-		myprintfn(2, "Using 'guessing' mode = smartguess (slower but increased winrate)\n");
-	} else if (GUESSING_MODE_var == 2) {
-		myprintfn(2, "Using 'guessing' mode = perfectmode (experimental, maximum winrate)\n");
+	// with -shard, only play my slice of the game indices; the boards still come from the whole-run index
+	if (RESUME_var == NULL) { first_game = int((long long)myruninfo.NUM_GAMES * (SHARD_var - 1) / NUM_SHARDS_var); }
+	int end_game = int((long long)myruninfo.NUM_GAMES * SHARD_var / NUM_SHARDS_var);
+	if (NUM_SHARDS_var > 1) {
+		myprintfn(2, "Playing shard %i of %i: games %i to %i of %i\n", SHARD_var, NUM_SHARDS_var, first_game + 1, end_game, myruninfo.NUM_GAMES);
+	}
+	if (WORKER_SLOT_var >= 0) {
+		// I'm one of the supervisor's workers, it already picked my range; and if I crash, just die, no dialog box
+		SetErrorMode(SEM_FAILCRITICALERRORS | SEM_NOGPFAULTERRORBOX);
+		first_game = WORKER_FIRST_var;
+		end_game = WORKER_END_var;
+		myprintfn(2, "Worker %i: playing games %i to %i of %i\n", WORKER_SLOT_var, first_game + 1, end_game, myruninfo.NUM_GAMES);
+	}
+	if (myruninfo.SPECIFY_SEED != 0) {
+		// replaying one game: it's the same stream it was in the run, because it has the same run seed and game index
+		first_game = int(myruninfo.SPECIFY_SEED - 1);
+		end_game = first_game + 1;
+		myruninfo.NUM_GAMES = end_game;
+	}
+	if ((end_game - first_game) < WORKERS_var) { WORKERS_var = end_game - first_game; } // no point in idle workers
+	if (WORKERS_var != 0) {
+		if (WORKERS_var < 1) { WORKERS_var = 1; }
+		myprintfn(2, "Playing the games in %i worker processes\n", WORKERS_var);
+		if (THREADS_var > 1) {
+			// 'which game was it on when it died' needs one game at a time per worker; use more workers instead
+			myprintfn(2, "Ignoring -threads, it can't be combined with -workers\n");
+			THREADS_var = 1;
+		}
 	}
 
-	// construct a trivial random generator engine from a time-based seed:
-	unsigned int seed = std::chrono::duration_cast<std::chrono::milliseconds>(
-		std::chrono::system_clock::now().time_since_epoch()
-		).count();
-	std::default_random_engine generator(seed);
-	std::uniform_int_distribution<int> distribution(1, INT_MAX - 1);
-	// note, to invoke use: distribution(generator);
+	if ((end_game - first_game) < THREADS_var) { THREADS_var = end_game - first_game; } // no point in idle threads
+	if (THREADS_var < 1) { THREADS_var = 1; }
+	if (THREADS_var > 1) {
+		myprintfn(2, "Playing %i games at once, on %i threads\n", THREADS_var, THREADS_var);
+		assert(TILE_THREADS_var == 1); // parse_input_args doesn't allow both
+	}
+	if (TILE_THREADS_var > 1) {
+		myprintfn(2, "Using %i threads for the logic inside each game\n", TILE_THREADS_var);
+	}
+	if (PIPELINE_var != 0) {
+		myprintfn(2, "Generating the boards ahead of time on %i threads\n", PIPELINE_var);
+	}
+	class threadpool tilepool; // -tthreads: the tiled logic inside each game runs on this; only ever 1 game at a time on it
+	tilepool.init(TILE_THREADS_var);
+	class threadpool * tiles = (THREADS_var == 1) ? &tilepool : NULL; // with -threads, each game runs its logic serially
+
+	// the run seed comes from the time (or -runseed); each game's rng is keyed by the run seed with the game index in its counter,
+	// so every game is its own independent stream and nothing is shared between games
+	unsigned long long runseed = RUNSEED_var;
+	if (runseed == 0) {
+		runseed = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch()
+			).count();
+	}
 
 
 	// seed random # generator
 	if (myruninfo.SPECIFY_SEED == 0) {
-		// create a new seed from time, log it, apply it
-		myprintfn(2, "Generating new seeds\n");
+		// the run seed is all it takes to replay any of the games, log it
+		myprintfn(2, "Generating the games from run seed %llu\n", runseed);
 	} else {
-		srand(myruninfo.SPECIFY_SEED);
-		myruninfo.NUM_GAMES = 1;
-		myprintfn(2, "Using seed %i for game 1\n", myruninfo.SPECIFY_SEED);
+		myprintfn(2, "Replaying game %llu of run seed %llu\n", myruninfo.SPECIFY_SEED, runseed);
 	}
 	fflush(myruninfo.logfile);
 
 
-	// init the 'game' object with the proper size
-	mygame.init(myruninfo.get_SIZEX(), myruninfo.get_SIZEY());
-	myrunstats.init_histogram(myruninfo.get_NUM_MINES());
-
-
-	for (int game = 0; game < myruninfo.NUM_GAMES; game++) {
-
-		// generate a new seed, log it, apply it... BUT only if not on the first game
-		if (myruninfo.SPECIFY_SEED == 0) {
-			int f = distribution(generator);
-			myprintfn(myruninfo.SCREEN + 1, "Using seed %i for game %i\n", f, game + 1);
-			srand(f);
-		}
-		// status tracker for impatient people
-		printf_s("Beginning game %i of %i\n", (game + 1), myruninfo.NUM_GAMES);
-
+	if (INFINITE_BUDGET_var != 0) {
+		// the endless field doesn't use 'mygame' or the normal stats at all
+		run_infinite_mode(runseed, first_game, end_game);
+		fclose(myruninfo.logfile);
+		if (USE_END_PAUSE_var) { system("pause"); }
+		return 0;
+	}
+	if (!PAIRED_var.empty()) {
+		// every board in every mode, with its own report
+		int r = run_paired_mode(runseed, first_game, end_game, tiles);
+		fclose(myruninfo.logfile);
+		if (USE_END_PAUSE_var) { system("pause"); }
+		return r;
+	}
 
-		// reset stat-tracking variables
-		mygamestats = game_stats();
-
-		// reset everything and generate new field, count how many 8-cells in the new field
-		myrunstats.games_with_eights += mygame.reset_for_game();
-
-		// play a game, capture the return value
-		int r = play_game();
-
-
-		myrunstats.strat_121_total +=		mygamestats.strat_121;
-		myrunstats.strat_nov_flag_total +=	mygamestats.strat_nov_flag;
-		myrunstats.strat_nov_safe_total +=	mygamestats.strat_nov_safe;
-		myrunstats.smartguess_attempts_total +=	mygamestats.smartguess_attempts;
-		myrunstats.smartguess_diff_total +=		mygamestats.smartguess_diff;
-		myrunstats.smartguess_valves_tripped_total += mygamestats.smartguess_valves_tripped;
-		myrunstats.games_with_smartguess_valves_tripped += bool(mygamestats.smartguess_valves_tripped);
-		myrunstats.total_luck_per_guess += mygamestats.luck_value_sum;
-
-		// increment run results depending on gamestate and gameresult
-		myrunstats.games_total++;
-		if (r == 0) { // game loss
-			mygamestats.trans_map += "X";
-			myrunstats.games_lost++;
-			myrunstats.inc_histogram(myruninfo.get_NUM_MINES() - mygame.get_mines_remaining());
-			// ................................. unused
-			myrunstats.num_guesses_in_losses += mygamestats.num_guesses;
-			myrunstats.total_luck_in_losses += mygamestats.luck_value_mult;
-			//if (mygamestats.began_solving == false) {
-			//	myrunstats.games_lost_beginning++;
-			//}
-			float remaining = float(mygame.get_mines_remaining()) / float(myruninfo.get_NUM_MINES());
-			if (remaining > 0.85) {
-				myrunstats.games_lost_earlygame++; // 0-15% completed
-			} else if (remaining > 0.15) {
-				myrunstats.games_lost_midgame++; // 15-85% completed
-			} else {
-				myrunstats.games_lost_lategame++; // 85-100% completed
-			}
-			// .................................
-		} else if (r == 1) { // game win
-			mygamestats.trans_map += "W";
-			myrunstats.games_won++;
-			myrunstats.num_guesses_in_wins += mygamestats.num_guesses;
-			myrunstats.total_luck_in_wins += mygamestats.luck_value_mult;
-			if (mygamestats.num_guesses > 0) {
-				myrunstats.games_won_guessing++;
+	// play all the games: on this thread like always, or spread across -threads workers that each own a game (mygame and
+	// mygamestats are per-thread) and their own run_stats, which get merged once everyone is done
+	if (RESUME_var == NULL) { myrunstats.init_histogram(myruninfo.get_NUM_MINES()); }
+	std::atomic<int> next_game(first_game);
+	std::vector<int> crashed; // -workers: the games that took down a worker
+	if (WORKER_SLOT_var >= 0) {
+		// I'm a worker: play my range like normal, publishing my stats into the shared block after every game
+		if (myworkerblock.open(WORKER_BLOCK_var, WORKER_SLOT_var + 1, myrunstats.flat_size())) { fclose(myruninfo.logfile); return 1; }
+		play_games(runseed, &next_game, end_game, (std::chrono::steady_clock::time_point::max)(), tiles, &myrunstats); // parentheses dodge the max() macro from Windows.h
+		myworkerblock.slot(WORKER_SLOT_var)->finished = 1;
+		fclose(myruninfo.logfile);
+		return 0; // the supervisor does the report
+	} else if (WORKERS_var != 0) {
+		if (run_supervisor_mode(runseed, first_game, end_game, &myrunstats, &crashed)) { fclose(myruninfo.logfile); return 1; }
+		next_game = end_game;
+	} else if (PIPELINE_var != 0) {
+		run_pipeline(runseed, first_game, end_game, tiles, &myrunstats);
+		next_game = end_game;
+	} else {
+		// ctrl+c stops taking new games and saves a checkpoint instead of just killing everything
+		if (myruninfo.SPECIFY_SEED == 0) { signal(SIGINT, on_interrupt); }
+		// the game-playing threads, kept from chunk to chunk so each one keeps its board and solver context
+		class threadpool gamepool;
+		gamepool.init(THREADS_var);
+		// with -checkpoint, play in chunks of CHECKPOINT_INTERVAL_SEC and save in between; without it, one chunk that never times out
+		// since each game's rng comes only from (run seed, game index), the next game index is all the rng state there is to save
+		// with -targetci, also stop at every multiple of TARGET_CI_CHECK_GAMES to see if the winrate is known well enough yet
+		while ((next_game < end_game) && !interrupted) {
+			std::chrono::steady_clock::time_point deadline = (std::chrono::steady_clock::time_point::max)();
+			if (CHECKPOINT_var != NULL) { deadline = std::chrono::steady_clock::now() + std::chrono::seconds(CHECKPOINT_INTERVAL_SEC); }
+			int chunk_end = end_game;
+			if (TARGET_CI_var != 0.) { chunk_end = (std::min)(end_game, ((next_game / TARGET_CI_CHECK_GAMES) + 1) * TARGET_CI_CHECK_GAMES); }
+			if (THREADS_var == 1) {
+				play_games(runseed, &next_game, chunk_end, deadline, tiles, &myrunstats);
 			} else {
-				myrunstats.games_won_noguessing++;
+				std::vector<struct run_stats> perthread(THREADS_var);
+				gamepool.run(THREADS_var, [&](int t) {
+					play_games(runseed, &next_game, chunk_end, deadline, tiles, &perthread[t]);
+				});
+				for (int t = 0; t < THREADS_var; t++) { myrunstats.merge(perthread[t]); }
+			}
+			// everyone is back, so every game before the counter is finished (the counter overshoots chunk_end at the end)
+			if (next_game > chunk_end) { next_game = chunk_end; }
+			if ((next_game == chunk_end) && (chunk_end < end_game) && reached_target_ci(&myrunstats)) {
+				myprintfn(2, "\nStopping early: the winrate is known to within +/- %.3f%% after %i games\n", TARGET_CI_var, chunk_end);
+				end_game = chunk_end; // so -statsout and the last checkpoint see a finished run
+				myruninfo.NUM_GAMES = end_game;
+			}
+			if ((CHECKPOINT_var != NULL) && !interrupted) { // the last one too, so a finished run's checkpoint can be merged like a -statsout
+				save_run_stats(CHECKPOINT_var, runseed, next_game);
+				fflush(myruninfo.logfile);
+			}
+		}
+		signal(SIGINT, SIG_DFL);
+		if (interrupted && (next_game < end_game)) {
+			// save where I got to, even without -checkpoint: next to the log, with .ckpt instead of .log
+			std::string ckpt = (CHECKPOINT_var != NULL) ? std::string(CHECKPOINT_var) : filepath.substr(0, filepath.size() - 4) + ".ckpt";
+			if (save_run_stats(ckpt.c_str(), runseed, next_game) == 0) {
+				myprintfn(2, "\nInterrupted after %i of %i games, continue with -resume %s\n", next_game - first_game, end_game - first_game, ckpt.c_str());
 			}
-		} else if (r == -1) {
-			mygamestats.trans_map += "?";
-			myrunstats.games_lost_unexpectedly++;
-			assert(0);
 		}
-
-		// print/log single-game results (also to console if #debug)
-		mygamestats.print_gamestats(myruninfo.SCREEN + 1, &mygame, &myruninfo);
-
-		//printf_s("Finished game %i of %i\n", (game+1), NUM_GAMES);
 	}
 
 	// done with games!
-	myrunstats.print_final_stats(&myruninfo);
+	myrunstats.print_final_stats(&myruninfo, FIND_EARLY_ZEROS_var, GUESSING_MODE_var);
+	if (!crashed.empty()) {
+		myprintfn(2, "\n%i games crashed or hung their worker (counted above as unexpected losses):\n", (int)crashed.size());
+		for (int i = 0; i < (int)crashed.size(); i++) {
+			myprintfn(2, "    Game %i, replay it with -runseed %llu -seed %i\n", crashed[i] + 1, runseed, crashed[i] + 1);
+		}
+	}
+
+	if ((STATSOUT_var != NULL) && (next_game >= end_game)) {
+		if (save_run_stats(STATSOUT_var, runseed, end_game) == 0) {
+			myprintfn(2, "Saved run stats to '%s'\n", STATSOUT_var);
+		}
+	}
 
 	fclose(myruninfo.logfile);
 	if (USE_END_PAUSE_var) { system("pause"); }
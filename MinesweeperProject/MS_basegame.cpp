@@ -4,6 +4,7 @@
 
 
 
+#include "MS_settings.h"
 #include "MS_basegame.h" // include myself
 
 
@@ -26,10 +27,242 @@ void runinfo::set_gamedata(int newx, int newy, int newmines) {
 		SIZEX = newx; SIZEY = newy; NUM_MINES = newmines;
 	}
 }
+// -sweep only: move on to the next configuration's x/y/mines, between batches of games while nothing is being played
+void runinfo::change_gamedata(int newx, int newy, int newmines) {
+	SIZEX = newx; SIZEY = newy; NUM_MINES = newmines;
+}
+
+// bitboard constructor, unusable until init() gives it a size
+bitboard::bitboard() {
+	width = 0; height = 0; words = 0; lastmask = 0;
+}
+// allocate the planes for an x by y field, all zero
+void bitboard::init(int x, int y) {
+	width = x; height = y;
+	words = (x + 63) / 64;
+	lastmask = ((x & 63) == 0) ? ~0ULL : ((1ULL << (x & 63)) - 1);
+	for (int i = 0; i < NUM_PLANES; i++) { planes[i].assign(words * height, 0); }
+	for (int i = 0; i < 4; i++) { sum[i].assign(words * height, 0); }
+	scratch.assign(words * height, 0);
+}
+// zero every plane, start of each game
+void bitboard::clear() {
+	for (int i = 0; i < NUM_PLANES; i++) { memset(&planes[i][0], 0, planes[i].size() * sizeof(uint64_t)); }
+}
+// the 3 bits x-1,x,x+1 of one row, packed into the low 3 bits, off-field bits are 0
+// the bits past the right edge are always 0 already, so only the word seams need special handling
+inline unsigned int bitboard::window3(const uint64_t * row, int x) {
+	int w = x >> 6; int b = x & 63;
+	if ((b >= 1) && (b <= 62)) { return (unsigned int)(row[w] >> (b - 1)) & 7; } // the usual case, all 3 in one word
+	unsigned int r = (unsigned int)((row[w] >> b) & 1) << 1;
+	if (b == 0) {
+		if (w > 0) { r |= (unsigned int)(row[w - 1] >> 63); }
+		r |= (unsigned int)((row[w] >> 1) & 1) << 2;
+	} else {
+		r |= (unsigned int)((row[w] >> 62) & 1);
+		if (w < words - 1) { r |= (unsigned int)(row[w + 1] & 1) << 2; }
+	}
+	return r;
+}
+// how many of the 8 neighbors of x,y are set in the plane: one popcount over the 3x3 window, minus the center
+int bitboard::count_around(const std::vector<uint64_t> & p, int x, int y) {
+	const uint64_t * row = &p[y * words];
+	unsigned int win = window3(row, x) & 5; // mask off the center
+	if (y > 0) { win |= window3(row - words, x) << 3; }
+	if (y < height - 1) { win |= window3(row + words, x) << 6; }
+	return popcount64(win);
+}
+// build the plane of UNKNOWN cells: not visible, not flagged, inside the field
+void bitboard::unknown_plane(std::vector<uint64_t> * out) {
+	out->resize(words * height);
+	for (int y = 0; y < height; y++) {
+		for (int w = 0; w < words; w++) {
+			int i = (y * words) + w;
+			(*out)[i] = ~(planes[PLANE_VISIBLE][i] | planes[PLANE_FLAGGED][i]) & ((w == words - 1) ? lastmask : ~0ULL);
+		}
+	}
+}
+// count the set neighbors of EVERY cell at once, the count is bit-sliced across 4 planes: n = sum[0] + 2*sum[1] + 4*sum[2] + 8*sum[3]
+// each of the 8 neighbor directions is a shifted copy of a row, and they are added in with a chain of half-adders, 64 cells at a time
+void bitboard::neighbor_sum(const std::vector<uint64_t> & p) {
+	for (int y = 0; y < height; y++) {
+		for (int w = 0; w < words; w++) {
+			uint64_t in[8]; int n = 0;
+			const uint64_t * row = &p[y * words];
+			in[n++] = from_left(row, w); in[n++] = from_right(row, w);
+			if (y > 0) {
+				const uint64_t * up = row - words;
+				in[n++] = from_left(up, w); in[n++] = up[w]; in[n++] = from_right(up, w);
+			}
+			if (y < height - 1) {
+				const uint64_t * down = row + words;
+				in[n++] = from_left(down, w); in[n++] = down[w]; in[n++] = from_right(down, w);
+			}
+			uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			for (int i = 0; i < n; i++) {
+				uint64_t c0 = s0 & in[i]; s0 ^= in[i];
+				uint64_t c1 = s1 & c0; s1 ^= c0;
+				uint64_t c2 = s2 & c1; s2 ^= c1;
+				s3 |= c2; // max is 8, so bit 3 can never carry
+			}
+			uint64_t m = (w == words - 1) ? lastmask : ~0ULL; // from_left drags a bit past the right edge, mask it off
+			int i = (y * words) + w;
+			sum[0][i] = s0 & m; sum[1][i] = s1 & m; sum[2][i] = s2 & m; sum[3][i] = s3 & m;
+		}
+	}
+}
+// grow every set bit into its 3x3 neighborhood, 'out' must not be 'p'
+void bitboard::dilate(const std::vector<uint64_t> & p, std::vector<uint64_t> * out) {
+	dilate(p, out, 0, height - 1);
+}
+// same, but only rows ylo-yhi of 'out' are written, and rows of 'p' outside that band are treated as empty
+void bitboard::dilate(const std::vector<uint64_t> & p, std::vector<uint64_t> * out, int ylo, int yhi) {
+	out->resize(words * height);
+	for (int y = ylo; y <= yhi; y++) {
+		for (int w = 0; w < words; w++) {
+			uint64_t d = 0;
+			for (int r = ((y > ylo) ? (y - 1) : y); r <= ((y < yhi) ? (y + 1) : y); r++) {
+				const uint64_t * row = &p[r * words];
+				d |= from_left(row, w) | row[w] | from_right(row, w);
+			}
+			(*out)[(y * words) + w] = d & ((w == words - 1) ? lastmask : ~0ULL); // from_left drags a bit past the right edge
+		}
+	}
+}
+// frontier: visible, not satisfied, and touching at least one unknown cell (= dilated unknown plane)
+void bitboard::frontier_plane(std::vector<uint64_t> * out) {
+	unknown_plane(&scratch);
+	dilate(scratch, out);
+	for (int i = 0; i < words * height; i++) {
+		(*out)[i] &= planes[PLANE_VISIBLE][i] & ~planes[PLANE_SATISFIED][i];
+	}
+}
+// index of the next set bit at or after x,y in reading order, as y*SIZEX+x, or -1 if there are none
+int bitboard::next_set(const std::vector<uint64_t> & p, int from) {
+	if (from >= width * height) { return -1; }
+	int y = from / width; int x = from % width;
+	int w = x >> 6;
+	uint64_t v = p[(y * words) + w] & (~0ULL << (x & 63)); // ignore the bits before x
+	while (true) {
+		if (v) {
+			return (y * width) + (w * 64) + ctz64(v);
+		}
+		w++;
+		if (w == words) { w = 0; y++; if (y == height) { return -1; } }
+		v = p[(y * words) + w];
+	}
+}
+
+// gamerng constructor, seeded with 0 until told otherwise
+gamerng::gamerng() {
+	seed(0, 0);
+}
+// start game number 'gameidx' of a run: key = run seed, counter = (game index, 0)
+void gamerng::seed(uint64_t runseed, uint64_t gameidx) {
+	assert((gameidx >> 63) == 0); // the top bit belongs to gamerng::block
+	key[0] = (uint32_t)runseed;
+	key[1] = (uint32_t)(runseed >> 32);
+	stream = gameidx;
+	ctr = 0;
+	bufpos = 4;
+}
+// skip ahead by n outputs without computing them
+void gamerng::skip(uint64_t n) {
+	uint64_t pos = (bufpos == 4) ? (ctr * 4) : (((ctr - 1) * 4) + bufpos); // how many outputs have been used so far
+	pos += n;
+	ctr = pos / 4;
+	bufpos = 4;
+	if ((pos % 4) != 0) { // landed partway thru a block, so generate it now
+		philox(key, ctr, stream, buf);
+		ctr++;
+		bufpos = (int)(pos % 4);
+	}
+}
+// next raw 32-bit output
+uint32_t gamerng::next() {
+	if (bufpos == 4) {
+		philox(key, ctr, stream, buf);
+		ctr++;
+		bufpos = 0;
+	}
+	return buf[bufpos++];
+}
+// uniform int in [0, n), without the modulo bias of rand() % n (Lemire's multiply-and-reject method)
+uint32_t gamerng::bounded(uint32_t n) {
+	uint64_t m = (uint64_t)next() * (uint64_t)n;
+	uint32_t low = (uint32_t)m;
+	if (low < n) {
+		uint32_t threshold = (0u - n) % n; // = 2^32 mod n, the size of the biased sliver
+		while (low < threshold) {
+			m = (uint64_t)next() * (uint64_t)n;
+			low = (uint32_t)m;
+		}
+	}
+	return (uint32_t)(m >> 32);
+}
+// one raw Philox block, for things that want random access instead of a stream (the infinite-mode chunks)
+void gamerng::block(uint64_t seed, uint64_t counter_lo, uint64_t counter_hi, uint32_t out[4]) {
+	assert((counter_hi >> 63) == 1);
+	uint32_t k[2] = { (uint32_t)seed, (uint32_t)(seed >> 32) };
+	philox(k, counter_lo, counter_hi, out);
+}
+// the actual Philox4x32 function: 10 rounds of multiply/xor over the counter, with the key bumped between rounds
+void gamerng::philox(const uint32_t k[2], uint64_t counter_lo, uint64_t counter_hi, uint32_t out[4]) {
+	uint32_t c0 = (uint32_t)counter_lo, c1 = (uint32_t)(counter_lo >> 32);
+	uint32_t c2 = (uint32_t)counter_hi, c3 = (uint32_t)(counter_hi >> 32);
+	uint32_t k0 = k[0], k1 = k[1];
+	for (int round = 0; round < 10; round++) {
+		uint64_t p0 = (uint64_t)0xD2511F53 * c0;
+		uint64_t p1 = (uint64_t)0xCD9E8D57 * c2;
+		uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+		uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+		c1 = (uint32_t)p1; c3 = (uint32_t)p0;
+		c0 = n0; c2 = n2;
+		k0 += 0x9E3779B9; k1 += 0xBB67AE85; // Weyl sequence key schedule
+	}
+	out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+// cellset constructor, unusable until init() gives it a field to index into
+cellset::cellset() {
+	items.clear();
+	pos.clear();
+	base = NULL;
+}
+// size the position array for a field of 'fieldsize' cells starting at 'newbase', and empty the set
+void cellset::init(class cell * newbase, int fieldsize) {
+	base = newbase;
+	items.clear();
+	items.reserve(fieldsize);
+	pos.assign(fieldsize, -1);
+}
+// empty the set, only touches the positions of the items that were in it
+void cellset::clear() {
+	for (int i = 0; i < (int)items.size(); i++) { pos[items[i] - base] = -1; }
+	items.clear();
+}
+// bulk-load an EMPTY set with these cells (no duplicates allowed), skips the one-at-a-time membership checks
+void cellset::fill(const std::vector<class cell *> & src) {
+	assert(items.empty());
+	items = src;
+	for (int i = 0; i < (int)items.size(); i++) { pos[items[i] - base] = i; }
+}
+// make this set a copy of another set over the same field, same item order; only touches the positions of the items
+void cellset::copy_from(const class cellset & src) {
+	if ((base != src.base) || (pos.size() != src.pos.size())) {
+		init(src.base, (int)src.pos.size());
+	} else {
+		clear();
+	}
+	fill(src.items);
+}
 
 // empty constructor: with no args, don't do much
 game::game() {
 	mines_remaining = 0;
+	correct_flags = 0;
+	incorrect_flags = 0;
+	unrevealed_safe = 0;
 	zerolist.clear();
 	unklist.clear();
 	field.clear();
@@ -39,35 +272,75 @@ game::game() {
 int game::init(int xxx, int yyy) {
 	game();
 	// create 'empty' field, for pasting onto the 'live' field to reset
-	class cell asdf2 = cell(); // needed for using the 'resize' command, I will overwrite the actual coords later
-	std::vector<class cell> asdf = std::vector<class cell>(); // init empty
-	asdf.resize(yyy, asdf2);									// fill it with copies of asdf2
-	asdf.shrink_to_fit();										// set capacity exactly where i want it, no bigger
-	field_blank = std::vector<std::vector<class cell>>();		// init empty
-	field_blank.resize(xxx, asdf);								// fill it with copies of asdf
-	field_blank.shrink_to_fit();								// set capacity exactly where i want it, no bigger
-	for (int m = 0; m < xxx; m++) {
-		for (int n = 0; n < yyy; n++) {
-			(field_blank[m][n]).x = m; // overwrite 0,0 with the correct coords
-			(field_blank[m][n]).y = n; // overwrite 0,0 with the correct coords
+	// one contiguous block of (x+2)*(y+2) cells, the outermost ring is BORDER so neighbor lookups never need a bounds check
+	stride = xxx + 2;
+	field_blank.assign(stride * (yyy + 2), cell());				// fill it with copies of a blank cell, reusing the old memory if a -sweep already sized it
+	for (int n = -1; n <= yyy; n++) {
+		for (int m = -1; m <= xxx; m++) {
+			class cell * c = &field_blank[((n + 1) * stride) + (m + 1)];
+			if ((m < 0) || (m >= xxx) || (n < 0) || (n >= yyy)) {
+				c->status = BORDER; // the padding ring
+			} // real cells don't store their coords, xof/yof get them from the position in the field
+		}
+	}
+	field = field_blank; // allocate the 'live' field once, afterwards it is only overwritten
+	// the neighbor table: which of the 8 offsets land on a real cell, computed once here so nobody has to check again
+	adj_mask.assign(field.size(), 0);
+	adj_count.assign(field.size(), 0);
+	all_cells.clear();
+	zerolist.init(&field[0], field.size()); // the sets index into the 'live' field, which never moves after this
+	unklist.init(&field[0], field.size());
+	bits.init(xxx, yyy);
+	frontier.init(&field[0], field.size());
+	border.init(&field[0], field.size());
+	unk_count.assign(field.size(), 0);
+	unk_mask.assign(field.size(), 0);
+	vis_count.assign(field.size(), 0);
+	vis_value.assign(field.size(), HIDDEN_CELL);
+	vis_effective.assign(field.size(), HIDDEN_CELL);
+	view.value = &vis_value[0];
+	view.effective = &vis_effective[0];
+	view.base = &field[0];
+	singlecell_dirty.assign(bits.words * yyy, 0);
+	twocell_dirty.assign(bits.words * yyy, 0);
+	singlecell_lo = twocell_lo = yyy; singlecell_hi = twocell_hi = -1;
+	pass_new.assign(bits.words * yyy, 0);
+	round_grow.assign(bits.words * yyy, 0);
+	pass_lo = grow_lo = yyy; pass_hi = grow_hi = -1;
+	pass_reach = 1; pass_cursor = -1;
+	flood_stack.reserve(xxx * yyy); // worst case, so the flood-fill never reallocates mid-game
+	// the 8 neighbor offsets, in the same order the old x/y loops visited them (left-to-right, top-to-bottom)
+	int i = 0;
+	for (int b = -1; b < 2; b++) {
+		for (int a = -1; a < 2; a++) {
+			if (a == 0 && b == 0) { continue; } // i am not adjacent to myself
+			adj_offset[i] = (b * stride) + a; i++;
+		}
+	}
+	for (int n = 0; n < yyy; n++) {
+		for (int m = 0; m < xxx; m++) {
+			int idx = ((n + 1) * stride) + (m + 1);
+			for (int j = 0; j < 8; j++) {
+				if (field[idx + adj_offset[j]].status != BORDER) { adj_mask[idx] |= (1 << j); }
+			}
+			adj_count[idx] = popcount64(adj_mask[idx]);
+			all_cells.push_back(&field[idx]);
 		}
 	}
 	return 0;
 }
 cell::cell() { // constructor
-	x = 0;
-	y = 0;
 	status = UNKNOWN;
 	value = 0;
 	effective = 0;
 }
 // read-only conditional accessor, only works if status == VISIBLE
 short unsigned int cell::get_value() {
-	if (status == VISIBLE) { return value; } else { myprintfn(2, "HEY! NO CHEATING! Can't peek at cell contents!\n"); return 100; }
+	if (status == VISIBLE) { return value; } else { myprintfn(2, "HEY! NO CHEATING! Can't peek at cell contents!\n"); return HIDDEN_CELL; }
 }
 // read-only conditional accessor, only works if status == VISIBLE
 short unsigned int cell::get_effective() {
-	if (status == VISIBLE) { return effective; } else { myprintfn(2, "HEY! NO CHEATING! Can't peek at cell contents!\n"); return 100; }
+	if (status == VISIBLE) { return effective; } else { myprintfn(2, "HEY! NO CHEATING! Can't peek at cell contents!\n"); return HIDDEN_CELL; }
 }
 
 
@@ -75,73 +348,106 @@ short unsigned int cell::get_effective() {
 
 
 // checks x and y against field size; if valid, return cell pointer. if invalid, return NULL
-// during single-cell and two-cell iterations, just use &field[x][y] because the X and Y are guaranteed not off the edge
+// during single-cell and two-cell iterations, just use cellat(x,y) because the X and Y are guaranteed not off the edge
 class cell * game::cellptr(int x, int y) {
-	if ((x < 0) || (x >= myruninfo.get_SIZEX()) || (y < 0) || (y >= myruninfo.get_SIZEY())) { return NULL; }
-	return &field[x][y];
+	if ((x < 0) || (x >= bits.width) || (y < 0) || (y >= bits.height)) { return NULL; }
+	return cellat(x, y);
 }
 
-// return a vector of the 3/5/8 cells surrounding the target
+// fill 'out' with the 3/5/8 cells surrounding the target, from the neighbor table; doesn't allocate
 // the order of the cells in the list will always be the same!!
-std::vector<class cell *> game::get_adjacent(class cell * me) {
-	std::vector<class cell *> adj_list;
-	adj_list.reserve(8); // resize it once since this will almost always be size 8
-	int x = me->x;
-	int y = me->y;
-	class cell * z;
-	for (int b = -1; b < 2; b++) {
-		for (int a = -1; a < 2; a++) {
-			if (a == 0 && b == 0)
-				continue; // i am not adjacent to myself
-			if ((z = cellptr(x + a, y + b)) != NULL) // simultaneous store and check for null
-				adj_list.push_back(z);
+void game::get_adjacent(class cell * me, struct adjlist * out) {
+	unsigned char m = adj_mask[me - &field[0]];
+	out->n = 0;
+	for (int i = 0; i < 8; i++) {
+		if ((m >> i) & 1) { out->c[out->n++] = me + adj_offset[i]; }
+	}
+}
+// fill 'out' with only the surrounding cells of the given state; doesn't allocate
+// BORDER cells never match the target, so the neighbor table isn't even needed here
+void game::filter_adjacent(class cell * me, cell_state target, struct adjlist * out) {
+	out->n = 0;
+	if (target == UNKNOWN) { // the common case, the live mask already knows the answer
+		unsigned int m = unk_mask[me - &field[0]];
+		while (m) {
+			int i = ctz64(m);
+			out->c[out->n++] = me + adj_offset[i];
+			m &= m - 1; // clear lowest bit
 		}
+		return;
+	}
+	for (int i = 0; i < 8; i++) {
+		class cell * z = me + adj_offset[i];
+		if (z->get_status() == target) { out->c[out->n++] = z; }
 	}
+}
+// fill 'out' with only the cells of 'adj' that have the given state; doesn't allocate
+void game::filter_adjacent(const struct adjlist & adj, cell_state target, struct adjlist * out) {
+	out->n = 0;
+	for (int i = 0; i < adj.n; i++) {
+		if (adj.c[i]->get_status() == target) { out->c[out->n++] = adj.c[i]; }
+	}
+}
 
-	return adj_list;
+// compatibility wrapper: return a vector of the 3/5/8 cells surrounding the target
+std::vector<class cell *> game::get_adjacent(class cell * me) {
+	struct adjlist adj;
+	get_adjacent(me, &adj);
+	return std::vector<class cell *>(adj.begin(), adj.end());
 }
 
 
 // uncovers the target cell, turning it from UNKNOWN to VISIBLE. also calculates the 'effective' value of the freshly-revealed cell
-// remove it from the unklist, and if it's a zero, remove it from the zero-list and recurse!
+// remove it from the unklist, and if it's a zero, remove it from the zero-list and flood-fill outward!
 // returns -1 if the cell was a mine (GAME LOSS), or the # of cells revealed otherwise
+// the zero cascade used to be recursive (one stack frame per cell, could overflow on big sparse boards), now it's a flood-fill
+// with an explicit stack: a cell is claimed (set VISIBLE) when it is pushed, so it can never be pushed twice.
+// the order cells are uncovered in is different, so cells leave the unklist in a different order and random guesses can
+// pick differently than the recursive version did; the count and every 'effective' value come out exactly the same
 int game::reveal(class cell * revealme) {
 	if ((revealme == NULL) || (revealme->status != UNKNOWN))
 		return 0; // if it is somehow null, or flagged, satisfied, or already visible, then do nothing. will happen often.
 
+	int retme = 0;
+	flood_stack.clear();
 	revealme->status = VISIBLE;
-	unklist.remove(revealme);
-	if (revealme->value == MINE) {
-		// lose the game, handled wherever calls here
-		return -1;
-	}
-	// if not a mine, set the freshly-revealed 'effective' value
-	std::vector<cell *> adjflag = filter_adjacent(revealme, FLAGGED);
-	revealme->effective = revealme->value - adjflag.size();
-
-	// if it's an effective zero, change status to SATISFIED and recurse, revealing adjacent cells
-	if (revealme->effective == 0) {
-		revealme->status = SATISFIED;
+	flood_stack.push_back(revealme);
+	while (!flood_stack.empty()) {
+		class cell * c = flood_stack.back();
+		flood_stack.pop_back();
+		bits.set(PLANE_VISIBLE, xof(c), yof(c));
+		unklist.remove(c);
+		leave_unknown(c, true);
+		if (c->value == MINE) {
+			// lose the game, handled wherever calls here
+			// (usually the first cell, but a cascade can get here too: it spreads from every effective zero it pops, and a
+			// cell whose flags are wrong can be an effective zero with an unflagged mine next to it)
+			return -1;
+		}
+		// if not a mine, set the freshly-revealed 'effective' value
+		c->effective = c->value - count_flagged_around(c);
+		vis_value[c - &field[0]] = c->value; // now the solver is allowed to see it
+		vis_effective[c - &field[0]] = c->effective;
+		unrevealed_safe--;
+		retme++;
+		mark_dirty(xof(c), yof(c)); // c and its neighbors have something new to think about
+		if (c->effective != 0)
+			continue; // if its an adjacency number, it doesn't spread
+
+		// if it's an effective zero, change status to SATISFIED and claim all adjacent unknowns
+		c->status = SATISFIED;
+		bits.set(PLANE_SATISFIED, xof(c), yof(c));
 		//if a true zero, remove it from the zero-list
-		if (revealme->value == 0) { zerolist.remove(revealme); }
-		int retme = 0;
-		int t = 0;
-		std::vector<class cell *> adj = filter_adjacent(revealme, UNKNOWN);
-		for (std::vector<class cell *>::iterator ptr = adj.begin(); ptr < adj.end(); ptr++) {
-			// ptr is a pointer to a pointer to a cell, therefore it needs dereferenced once
-			t = reveal(*ptr);
-			if (t == -1) {
-				return -1;
-			} else {
-				retme += t;
+		if (c->value == 0) { zerolist.remove(c); }
+		for (int i = 0; i < 8; i++) {
+			class cell * z = c + adj_offset[i];
+			if (z->status == UNKNOWN) { // BORDER is never UNKNOWN
+				z->status = VISIBLE;
+				flood_stack.push_back(z);
 			}
 		}
-		return retme + 1; // return the number of cells revealed
-	} else {
-		// if its an adjacency number, return 1
-		return 1;
 	}
-	return 0; // dangling return just in case
+	return retme; // return the number of cells revealed
 }
 
 // sets cell state to FLAGGED, reduces # remaining mines, reduce "effective" values of everything visible around it
@@ -156,79 +462,239 @@ int game::set_flag(class cell * flagme) {
 	}
 
 	unklist.remove(flagme);
+	leave_unknown(flagme, false);
 	flagme->status = FLAGGED; // set it to flagged, like it should be
+	bits.set(PLANE_FLAGGED, xof(flagme), yof(flagme));
 
 
 	// decrement "effective" values of everything visible around it
-	std::vector<class cell *> adj = filter_adjacent(flagme, VISIBLE);
-	for (int i = 0; i < adj.size(); i++) {
-		adj[i]->effective--;
+	struct adjlist adj;
+	filter_adjacent(flagme, VISIBLE, &adj);
+	for (int i = 0; i < adj.n; i++) {
+		adj.c[i]->effective--;
+		vis_effective[adj.c[i] - &field[0]]--;
 	}
+	mark_dirty(xof(flagme), yof(flagme)); // the flag itself isn't VISIBLE, but its neighbors are
+
+	if (flagme->value == MINE) { correct_flags++; } else { incorrect_flags++; }
 
 	// decrement the remaining mines
 	mines_remaining -= 1;
 	if (mines_remaining < 0) {
 		myprintfn(2, "ERR: PLACED TOO MANY FLAGS\n"); assert(0); system("pause");
 	} else if (mines_remaining == 0) {
-		//try to validate the win: every mine is flagged, and every not-mine is not-flagged
-		for (int y = 0; y < myruninfo.get_SIZEY(); y++) {
-			for (int x = 0; x < myruninfo.get_SIZEX(); x++) { // iterate over each cell
-				class cell * v = &field[x][y];
-
-				if (v->value == MINE) {
-					// assert that every mine is flagged
-					if (v->status != FLAGGED) {
-						myprintfn(2, "ERR: IN WIN VALIDATION, FOUND AN UNFLAGGED MINE\n");
-						assert(0);
-					}
-				}
-				if (v->value != MINE) {
-					// assert that every not-mine is not-flagged
-					if (v->status == FLAGGED) {
-						myprintfn(2, "ERR: IN WIN VALIDATION, FOUND A FLAGGED NOT-MINE\n");
-						assert(0);
-					}
+		// validate the win: every mine is flagged, and every not-mine is not-flagged... the counters already know this
+		if ((correct_flags != myruninfo.get_NUM_MINES()) || (incorrect_flags != 0)) {
+			myprintfn(2, "ERR: IN WIN VALIDATION, %i MINES UNFLAGGED AND %i NOT-MINES FLAGGED\n", myruninfo.get_NUM_MINES() - correct_flags, incorrect_flags);
+			assert(0);
+		}
+		if (WIN_VALIDATION_FULL_AUDIT) {
+			// debug only: walk every cell and make sure the counters are telling the truth
+			int unflagged_mines = 0; int flagged_safe = 0; int hidden_safe = 0;
+			for (int y = 0; y < myruninfo.get_SIZEY(); y++) {
+				for (int x = 0; x < myruninfo.get_SIZEX(); x++) { // iterate over each cell
+					class cell * v = cellat(x, y);
+					if ((v->value == MINE) && (v->status != FLAGGED)) { unflagged_mines++; }
+					if ((v->value != MINE) && (v->status == FLAGGED)) { flagged_safe++; }
+					if ((v->value != MINE) && (v->status == UNKNOWN)) { hidden_safe++; }
 				}
 			}
+			if (unflagged_mines != 0) { myprintfn(2, "ERR: IN WIN VALIDATION, FOUND AN UNFLAGGED MINE\n"); assert(0); }
+			if (flagged_safe != 0) { myprintfn(2, "ERR: IN WIN VALIDATION, FOUND A FLAGGED NOT-MINE\n"); assert(0); }
+			if ((flagged_safe != incorrect_flags) || (hidden_safe != unrevealed_safe)) {
+				myprintfn(2, "ERR: IN WIN VALIDATION, AUDIT DISAGREES WITH THE COUNTERS\n"); assert(0);
+			}
 		}
 		return -1; // officially won!
 	}
 	return 1; // successfully flagged a cell
 }
 
-// basically the same as get_adjacent but returns only cells of the given state
+// compatibility wrapper: basically the same as get_adjacent but returns only cells of the given state
 // can plausibly return an empty vector... this version takes a cell pointer
 std::vector<class cell *> game::filter_adjacent(class cell * me, cell_state target) {
-	std::vector<class cell *> filt_list;
-	filt_list.reserve(8); // resize it once since this will be at most 8
-	int x = me->x; int y = me->y;
-	class cell * z;
-	for (int b = -1; b < 2; b++) {
-		for (int a = -1; a < 2; a++) {
-			if (a == 0 && b == 0) { continue; } // i am not adjacent to myself
-			z = cellptr(x + a, y + b);
-			if ((z != NULL) && (z->get_status() == target)) // check for null and check cell state
-				filt_list.push_back(z);
-		}
-	}
-	return filt_list;
+	struct adjlist filt;
+	filter_adjacent(me, target, &filt);
+	return std::vector<class cell *>(filt.begin(), filt.end());
 }
 
 
-// basically the same as get_adjacent but returns only cells of the given state
+// compatibility wrapper: basically the same as get_adjacent but returns only cells of the given state
 // can plausibly return an empty vector... this version takes an adjacency vector
-std::vector<class cell *> game::filter_adjacent(std::vector<class cell *> adj, cell_state target) {
-	int i = 0;
-	while (i < adj.size()) {
-		if (adj[i]->get_status() != target)
-			adj.erase(adj.begin() + i);
-		else
-			i++;
+std::vector<class cell *> game::filter_adjacent(const std::vector<class cell *> & adj, cell_state target) {
+	std::vector<class cell *> filt;
+	filt.reserve(adj.size());
+	for (int i = 0; i < (int)adj.size(); i++) {
+		if (adj[i]->get_status() == target) { filt.push_back(adj[i]); }
 	}
-	return adj;
+	return filt;
 }
 
 
+// how many of the 8 neighbors are FLAGGED, from the bit-planes
+int game::count_flagged_around(class cell * me) {
+	return bits.count_around(PLANE_FLAGGED, xof(me), yof(me));
+}
+// fill 'out' with the frontier: VISIBLE (not satisfied) cells that touch at least one UNKNOWN cell, in reading order
+// the live frontier set already has them, just need to put them in order (field is one block, so pointer order IS reading order)
+void game::get_frontier(std::vector<class cell *> * out) {
+	out->assign(frontier.begin(), frontier.end());
+	std::sort(out->begin(), out->end());
+}
+// update the neighborhood summaries/frontier/border when 'me' stops being UNKNOWN, called by reveal and set_flag
+// a satisfied cell never has unknown neighbors, so 'revealed next to an unknown' is the same as 'VISIBLE next to an unknown'
+void game::leave_unknown(class cell * me, bool revealed) {
+	int idx = (int)(me - &field[0]);
+	border.remove(me);
+	unsigned char m = adj_mask[idx];
+	for (int i = 0; i < 8; i++) {
+		if (!((m >> i) & 1)) { continue; }
+		int n = idx + adj_offset[i];
+		unk_count[n]--;
+		unk_mask[n] &= ~(1 << (7 - i)); // I am their neighbor 7-i
+		if (unk_count[n] == 0) { frontier.remove(&field[n]); } // does nothing if it isn't there
+		if (revealed) {
+			vis_count[n]++;
+			if ((field[n].get_status() == UNKNOWN) && (vis_count[n] == 1)) { border.push_back(&field[n]); }
+		}
+	}
+	if (revealed && (unk_count[idx] > 0)) { frontier.push_back(me); } // if it ends up satisfied, its count will hit 0 and remove it
+}
+// sets cell status to SATISFIED, and keeps the bit-planes in sync
+// doesn't need to mark anything dirty: a satisfied cell has effective 0, so no strategy could use it anyway
+void game::set_satisfied(class cell * me) {
+	me->status = SATISFIED;
+	bits.set(PLANE_SATISFIED, xof(me), yof(me));
+}
+// empty one worklist into 'out': every VISIBLE cell within 'reach' steps of a dirty cell, in reading order
+// the dirty bits are grown by dilating the plane, so this costs a few word ops per row no matter how many cells are dirty
+void game::get_worklist_round(std::vector<uint64_t> * dirty, int * lo, int * hi, int reach, std::vector<class cell *> * out) {
+	out->clear();
+	// start the pass: nothing has been done in it yet, and nothing from the last pass carries over
+	for (int i = grow_lo * bits.words; i < (grow_hi + 1) * bits.words; i++) { round_grow[i] = 0; }
+	for (int i = pass_lo * bits.words; i < (pass_hi + 1) * bits.words; i++) { pass_new[i] = 0; }
+	pass_lo = grow_lo = bits.height; pass_hi = grow_hi = -1;
+	pass_reach = reach; pass_cursor = -1;
+	if (*lo > *hi) { return; } // nothing revealed or flagged since last time
+	// only the rows within 'reach' of a dirty row can end up in the round
+	int ylo = *lo - reach; if (ylo < 0) { ylo = 0; }
+	int yhi = *hi + reach; if (yhi > bits.height - 1) { yhi = bits.height - 1; }
+	round_bits.resize(dirty->size());
+	for (int i = ylo * bits.words; i < (yhi + 1) * bits.words; i++) {
+		round_bits[i] = (*dirty)[i]; // rows outside lo-hi are clean, so this also zeroes the margin
+		(*dirty)[i] = 0;
+	}
+	*lo = bits.height; *hi = -1;
+	for (int r = 0; r < reach; r++) {
+		bits.dilate(round_bits, &round_tmp, ylo, yhi);
+		round_bits.swap(round_tmp);
+	}
+	for (int y = ylo; y <= yhi; y++) {
+		for (int w = 0; w < bits.words; w++) {
+			int i = (y * bits.words) + w;
+			uint64_t v = round_bits[i] & bits.planes[PLANE_VISIBLE][i] & ~bits.planes[PLANE_SATISFIED][i];
+			while (v) {
+				out->push_back(cellat((w * 64) + ctz64(v), y));
+				v &= v - 1; // clear the lowest set bit
+			}
+		}
+	}
+}
+// walk the pass in progress: the next cell in reading order that is either the next one left in 'round' (from *i on) or
+// within reach of something revealed or flagged earlier in this pass; *k = its index in 'round', or -1 if it came in partway
+// the old full-field scans saw those cells in the same pass too, so this keeps every strategy firing in the same order
+// returns NULL once the pass is done
+class cell * game::next_in_round(const std::vector<class cell *> & round, int * i, int * k) {
+	if (pass_lo <= pass_hi) {
+		// grow whatever was done since the last call by the pass's reach, into round_grow: usually only a word or two has
+		// anything in it, so each one is smeared sideways and ORed into the rows around it instead of dilating whole rows
+		int r = pass_reach;
+		for (int y = pass_lo; y <= pass_hi; y++) {
+			for (int w = 0; w < bits.words; w++) {
+				uint64_t v = pass_new[(y * bits.words) + w];
+				if (!v) { continue; }
+				pass_new[(y * bits.words) + w] = 0;
+				uint64_t mid = v, lo = 0, hi = 0; // lo/hi are the bits that spill into the words before/after
+				for (int d = 1; d <= r; d++) { mid |= (v << d) | (v >> d); lo |= v << (64 - d); hi |= v >> (64 - d); }
+				for (int yy = ((y - r < 0) ? 0 : (y - r)); yy <= ((y + r > bits.height - 1) ? (bits.height - 1) : (y + r)); yy++) {
+					uint64_t * row = &round_grow[yy * bits.words];
+					row[w] |= mid; // bits past the right edge don't matter, they never match a VISIBLE cell
+					if (w > 0) { row[w - 1] |= lo; }
+					if (w < bits.words - 1) { row[w + 1] |= hi; }
+				}
+			}
+		}
+		if (pass_lo - r < grow_lo) { grow_lo = (pass_lo - r < 0) ? 0 : (pass_lo - r); }
+		if (pass_hi + r > grow_hi) { grow_hi = (pass_hi + r > bits.height - 1) ? (bits.height - 1) : (pass_hi + r); }
+		pass_lo = bits.height; pass_hi = -1;
+	}
+	// the next one in the list, and the first grown cell after the cursor, if that comes before it
+	int listpos = (*i < (int)round.size()) ? ((yof(round[*i]) * bits.width) + xof(round[*i])) : (bits.width * bits.height);
+	int found = -1;
+	int from = pass_cursor + 1;
+	if (from < grow_lo * bits.width) { from = grow_lo * bits.width; }
+	for (int y = from / bits.width; (found < 0) && (y <= grow_hi) && (y * bits.width <= listpos); y++) {
+		int wfrom = (y == from / bits.width) ? ((from % bits.width) >> 6) : 0;
+		for (int w = wfrom; (w < bits.words) && ((y * bits.width) + (w * 64) <= listpos); w++) {
+			int j = (y * bits.words) + w;
+			uint64_t v = round_grow[j] & bits.planes[PLANE_VISIBLE][j] & ~bits.planes[PLANE_SATISFIED][j];
+			if ((y == from / bits.width) && (w == wfrom)) { v &= ~0ULL << ((from % bits.width) & 63); } // the cursor's word
+			if (v) { found = (y * bits.width) + (w * 64) + ctz64(v); break; }
+		}
+	}
+	if (found > listpos) { found = -1; }
+	if (found >= 0) {
+		round_grow[((found / bits.width) * bits.words) + ((found % bits.width) >> 6)] &= ~(1ULL << ((found % bits.width) & 63));
+	}
+	if ((found >= 0) && (found < listpos)) {
+		pass_cursor = found;
+		*k = -1;
+		return cellat(found % bits.width, found / bits.width);
+	}
+	if (*i >= (int)round.size()) { return NULL; }
+	pass_cursor = listpos;
+	*k = *i;
+	(*i)++;
+	return round[*k];
+}
+// the cells single-cell logic needs to look at: VISIBLE cells touching anything revealed or flagged since the last round
+void game::get_singlecell_round(std::vector<class cell *> * out) {
+	get_worklist_round(&singlecell_dirty, &singlecell_lo, &singlecell_hi, 1, out);
+}
+// the cells two-cell logic needs to look at: every VISIBLE cell within 3 of anything revealed or flagged since the last round
+// (a changed cell alters its neighbors, and each of those can be the 'other' for any center in its 5x5)
+void game::get_twocell_round(std::vector<class cell *> * out) {
+	get_worklist_round(&twocell_dirty, &twocell_lo, &twocell_hi, 3, out);
+}
+
+
+// true if one worklist has any bit set within 'reach' steps of x,y
+// the row span makes the common answer (nothing has happened anywhere near here) a couple of compares
+bool game::dirty_near(const std::vector<uint64_t> & dirty, int lo, int hi, int xxx, int yyy, int reach) {
+	if ((yyy + reach < lo) || (yyy - reach > hi)) { return false; }
+	int ylo = yyy - reach; if (ylo < lo) { ylo = lo; }
+	int yhi = yyy + reach; if (yhi > hi) { yhi = hi; }
+	int xlo = xxx - reach; if (xlo < 0) { xlo = 0; }
+	int xhi = xxx + reach; if (xhi > bits.width - 1) { xhi = bits.width - 1; }
+	for (int y = ylo; y <= yhi; y++) {
+		for (int w = xlo >> 6; w <= (xhi >> 6); w++) {
+			uint64_t m = ~0ULL;
+			if (w == (xlo >> 6)) { m &= ~0ULL << (xlo & 63); }
+			if (w == (xhi >> 6)) { m &= ~0ULL >> (63 - (xhi & 63)); }
+			if (dirty[(y * bits.words) + w] & m) { return true; }
+		}
+	}
+	return false;
+}
+// single-cell logic on 'me' only sees its 8 neighbors (their status, and the flags that make up its effective value)
+bool game::singlecell_changed_near(class cell * me) {
+	return dirty_near(singlecell_dirty, singlecell_lo, singlecell_hi, xof(me), yof(me), 1);
+}
+// two-cell logic on 'me' sees every cell in its 5x5, and each of those sees its own 8 neighbors
+bool game::twocell_changed_near(class cell * me) {
+	return dirty_near(twocell_dirty, twocell_lo, twocell_hi, xof(me), yof(me), 3);
+}
+
 
 // print: either 1) fully-revealed field, 2) in-progress field as seen by human, 3) in-progress field showing 'effective' values
 // borders made with +, zeros= blank, adjacency (or effective)= number, unknown= -, flag or mine= *
@@ -251,27 +717,28 @@ void game::print_field(int mode, int screen) {
 	std::string line;
 	for (int y = 0; y < myruninfo.get_SIZEY(); y++) {
 		for (int x = 0; x < myruninfo.get_SIZEX(); x++) {
-			if ((field[x][y].status == UNKNOWN) && (mode != 1)) {
+			class cell * c = cellat(x, y);
+			if ((c->status == UNKNOWN) && (mode != 1)) {
 				// if mode==full, fall through
 				line += "- "; continue;
 			}
 			// if visible and a mine, this is where the game was lost
-			if ((field[x][y].status == VISIBLE) && (field[x][y].value == MINE)) {
+			if ((c->status == VISIBLE) && (c->value == MINE)) {
 				line += "X "; continue;
 			}
 			// below here assume the cell is visible/flagged/satified
-			if ((field[x][y].status == FLAGGED) || (field[x][y].value == MINE)) {
+			if ((c->status == FLAGGED) || (c->value == MINE)) {
 				line += "* "; continue;
 			}
 			// below here assumes the cell is a visible adjacency number
-			if ((field[x][y].value == 0) || ((mode == 3) && (field[x][y].effective == 0))) {
+			if ((c->value == 0) || ((mode == 3) && (c->effective == 0))) {
 				line += "  "; continue;
 			}
 			char buf[3];
 			if (mode == 3)
-				sprintf_s(buf, "%d", field[x][y].effective);
+				sprintf_s(buf, "%d", c->effective);
 			else
-				sprintf_s(buf, "%d", field[x][y].value);
+				sprintf_s(buf, "%d", c->value);
 			line += buf;
 			line += " ";
 		}
@@ -290,60 +757,118 @@ void game::print_field(int mode, int screen) {
 // reset the field, place new mines, set 'value' for non-mine cells, clear and repopulate the lists, etc
 // returns the number of 8-cells found when generating (just because I can)
 // also prints the fully-revealed field after doing all this
-int game::reset_for_game() {
+int game::reset_for_game(const struct boardsnapshot * replay) {
 	// reset the 'live' field
-	//memcpy(field, field_blank, get_SIZEX() * get_SIZEY() * sizeof(class cell)); // paste
-	field = field_blank; // paste
+	memcpy(&field[0], &field_blank[0], field.size() * sizeof(class cell)); // paste, one block copy since the field is contiguous
 
 	zerolist.clear(); // reset the list
 	unklist.clear();
+	frontier.clear();
+	border.clear();
+	// everything starts out unknown, so the summaries start as copies of the neighbor tables
+	memcpy(&unk_count[0], &adj_count[0], field.size());
+	memcpy(&unk_mask[0], &adj_mask[0], field.size());
+	memset(&vis_count[0], 0, field.size());
+	memset(&vis_value[0], HIDDEN_CELL, field.size());
+	memset(&vis_effective[0], HIDDEN_CELL, field.size());
+	bits.clear();
+	memset(&singlecell_dirty[0], 0, singlecell_dirty.size() * sizeof(uint64_t));
+	memset(&twocell_dirty[0], 0, twocell_dirty.size() * sizeof(uint64_t));
+	singlecell_lo = twocell_lo = bits.height; singlecell_hi = twocell_hi = -1;
+	memset(&pass_new[0], 0, pass_new.size() * sizeof(uint64_t));
+	memset(&round_grow[0], 0, round_grow.size() * sizeof(uint64_t));
+	pass_lo = grow_lo = bits.height; pass_hi = grow_hi = -1;
+	pass_cursor = -1;
 	mines_remaining = myruninfo.get_NUM_MINES();
-
-	// generate the mines
-	for (int i = 0; i < myruninfo.get_NUM_MINES(); i++) {
-		int x = rand() % myruninfo.get_SIZEX(); int y = rand() % myruninfo.get_SIZEY();
-		if (field[x][y].value == MINE) {
-			i--; continue; // if already a mine, generate again
-		}
-		field[x][y].value = MINE;
-		field[x][y].effective = MINE; // why not
+	correct_flags = 0;
+	incorrect_flags = 0;
+	unrevealed_safe = (myruninfo.get_SIZEX() * myruninfo.get_SIZEY()) - myruninfo.get_NUM_MINES();
+
+	// generate the mines (Floyd's algorithm, see place_mines)
+	int X = myruninfo.get_SIZEX();
+	if (replay != NULL) {
+		// same board as before (or made ahead of time by generate_board): copy its mines in, and put the rng where it was
+		// right after placing them
+		bits.planes[PLANE_MINE] = replay->mines;
+		rng = replay->rng;
+	} else {
+		place_mines(&rng, &bits.planes[PLANE_MINE], bits.words);
 	}
 
-	int eights = 0;
-	// set up adjacency values, also populate zero-list and unk-list
-	for (int y = 0; y < myruninfo.get_SIZEY(); y++) {
-		for (int x = 0; x < myruninfo.get_SIZEX(); x++) { // iterate over the field
-			unklist.push_back(&field[x][y]); // everything starts out in the unklist
-
-			if (field[x][y].value == MINE)
-				continue; // don't touch existing mines
-			std::vector<class cell *> adj = get_adjacent(&field[x][y]);
-			int t = 0;
-			for (int j = 0; j < adj.size(); j++) {
-				if (adj[j]->value == MINE) { t++; }
-			}
-			field[x][y].value = t;
-			field[x][y].effective = t;
+	// count the mines around every cell at once, from the mine plane
+	bits.neighbor_sum(bits.planes[PLANE_MINE]);
 
-			if (t == 0) {
-				zerolist.push_back(&field[x][y]);
-			}
-			if (t == 8) {
-				myprintfn(2, "Found an 8 cell when generating, you must be lucky! This is incredibly rare!\n");
-				eights++;
+	// set up adjacency values from the bit-sliced counts, 64 cells per word
+	for (int y = 0; y < myruninfo.get_SIZEY(); y++) {
+		for (int w = 0; w < bits.words; w++) {
+			int i = (y * bits.words) + w;
+			uint64_t mines = bits.planes[PLANE_MINE][i];
+			uint64_t s0 = bits.sum[0][i], s1 = bits.sum[1][i], s2 = bits.sum[2][i], s3 = bits.sum[3][i];
+			int xmax = ((w + 1) * 64 < X) ? 64 : (X - (w * 64));
+			class cell * c = cellat(w * 64, y);
+			for (int b = 0; b < xmax; b++, c++) {
+				if ((mines >> b) & 1) {
+					c->value = MINE;
+					c->effective = MINE; // why not
+				} else {
+					int t = int((s0 >> b) & 1) | (int((s1 >> b) & 1) << 1) | (int((s2 >> b) & 1) << 2) | (int((s3 >> b) & 1) << 3);
+					c->value = t;
+					c->effective = t;
+				}
 			}
 		}
 	}
 
+	// everything starts out in the unklist, bulk-load it
+	unklist.fill(all_cells);
+	// zeros = not a mine and no bits in any of the 4 count planes; 8s = bit 3 set (the max is 8, so that's the only way)
+	// build the zero plane into 'sum[0]' since it's not needed after this
+	int eights = 0;
+	for (int i = 0; i < bits.words * myruninfo.get_SIZEY(); i++) {
+		uint64_t valid = (((i % bits.words) == bits.words - 1) && ((X & 63) != 0)) ? ((1ULL << (X & 63)) - 1) : ~0ULL;
+		eights += popcount64(bits.sum[3][i] & ~bits.planes[PLANE_MINE][i]);
+		bits.sum[0][i] = ~(bits.sum[0][i] | bits.sum[1][i] | bits.sum[2][i] | bits.sum[3][i] | bits.planes[PLANE_MINE][i]) & valid;
+	}
+	for (int i = bits.next_set(bits.sum[0], 0); i != -1; i = bits.next_set(bits.sum[0], i + 1)) {
+		zerolist.push_back(cellat(i % X, i / X));
+	}
+	for (int i = 0; i < eights; i++) {
+		myprintfn(2, "Found an 8 cell when generating, you must be lucky! This is incredibly rare!\n");
+	}
+
 	// print the fully-revealed field to screen only if SCREEN==2
 	print_field(1, myruninfo.SCREEN);
 
-	zerolist.sort(sort_cells);
-	unklist.sort(sort_cells);
-	// don't really need to sort the lists, because the find-and-remove method iterates linearly instead of using
-	//   a BST, but it makes me feel better to know its sorted. and I only sort it once per game, so its fine.
+	// no sorting the lists: they start out in reading order, and the swap-remove scrambles them anyway
 	return eights;
 }
+// save the board that reset_for_game just set up, before any moves are made on it
+void game::save_board(struct boardsnapshot * out) {
+	out->mines = bits.planes[PLANE_MINE];
+	out->rng = rng;
+}
+// place NUM_MINES mines into an all-zero mine plane ('words' uint64s per row) with Floyd's algorithm, drawing from 'rng'
+// picks NUM_MINES distinct cell indices out of SIZEX*SIZEY, uniformly, with exactly one draw per mine; the old 'pick x/y,
+// try again if already a mine' got very slow at high density. the plane doubles as the "already picked" set
+void place_mines(class gamerng * rng, std::vector<uint64_t> * plane, int words) {
+	int X = myruninfo.get_SIZEX();
+	int N = X * myruninfo.get_SIZEY();
+	uint64_t * p = &(*plane)[0];
+	for (int j = N - myruninfo.get_NUM_MINES(); j < N; j++) {
+		int t = rng->bounded(j + 1); // uniform in [0, j]
+		int w = ((t / X) * words) + ((t % X) >> 6);
+		if ((p[w] >> ((t % X) & 63)) & 1) { t = j; w = ((t / X) * words) + ((t % X) >> 6); } // if t was already picked, j can't have been, so take j instead
+		p[w] |= (1ULL << ((t % X) & 63));
+	}
+}
+// generate the board for this game without any game object (so any thread can do it): exactly the mines and rng state that
+// reset_for_game would have after rng.seed(runseed, gameidx), ready to be played with reset_for_game(out)
+void generate_board(uint64_t runseed, uint64_t gameidx, struct boardsnapshot * out) {
+	int words = (myruninfo.get_SIZEX() + 63) / 64;
+	out->rng.seed(runseed, gameidx);
+	out->mines.assign(words * myruninfo.get_SIZEY(), 0); // reuses the memory after the first time
+	place_mines(&out->rng, &out->mines, words);
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -361,7 +886,7 @@ void myprintfn(int p, const char* fmt, ...) {
 // cells are sorted in reading-order, where 0,0 is top-left, +x is right and +y is down...
 // if a goes first, return negative; if b goes first, return positive; if identical, return 0
 inline int compare_two_cells(class cell * a, class cell * b) {
-	return ((a->y * myruninfo.get_SIZEX()) + a->x) - ((b->y * myruninfo.get_SIZEX()) + b->x);
+	return (int)(a - b); // the field is one block in reading order, so the pointer order IS the reading order
 }
 // if a goes before b, return true... needed for consistient sorting
 // use compare_two_cells to sort
@@ -374,8 +899,8 @@ bool sort_cells(class cell * a, class cell * b) {
 // NOTE: i could templatize this function, but A) there's no need to, and B) I'd have to put it in the header
 std::vector<std::vector<class cell *>> extract_overlap(std::vector<class cell *> me_unk, std::vector<class cell *> other_unk) {
 	std::vector<class cell *> overlap = std::vector<class cell *>();
-	for (int i = 0; i < me_unk.size(); i++) { // for each cell in me_unk...
-		for (int j = 0; j < other_unk.size(); j++) { // ...compare against each cell in other_unk...
+	for (int i = 0; i < (int)me_unk.size(); i++) { // for each cell in me_unk...
+		for (int j = 0; j < (int)other_unk.size(); j++) { // ...compare against each cell in other_unk...
 			if (me_unk[i] == other_unk[j]) {// ...until there is a match!
 				overlap.push_back(me_unk[i]);
 				me_unk.erase(me_unk.begin() + i);
@@ -389,15 +914,40 @@ std::vector<std::vector<class cell *>> extract_overlap(std::vector<class cell *>
 	retme.push_back(me_unk); retme.push_back(other_unk); retme.push_back(overlap);
 	return retme;
 }
+// extract_overlap for neighbor lists: same outputs in the same order, but written into caller-provided lists so nothing is allocated
+void extract_overlap(const struct adjlist & me_unk, const struct adjlist & other_unk, struct adjlist * me_only, struct adjlist * other_only, struct adjlist * overlap) {
+	me_only->n = 0; other_only->n = 0; overlap->n = 0;
+	unsigned int matched = 0; // bit j set when other_unk[j] was found in me_unk
+	for (int i = 0; i < me_unk.n; i++) {
+		int j = 0;
+		for (; j < other_unk.n; j++) {
+			if (!((matched >> j) & 1) && (me_unk.c[i] == other_unk.c[j])) { break; }
+		}
+		if (j < other_unk.n) {
+			matched |= (1 << j);
+			overlap->push_back(me_unk.c[i]);
+		} else {
+			me_only->push_back(me_unk.c[i]);
+		}
+	}
+	for (int j = 0; j < other_unk.n; j++) {
+		if (!((matched >> j) & 1)) { other_only->push_back(other_unk.c[j]); }
+	}
+}
 
 
 
 // return a random object from the provided list, or NULL if the list is empty
 // NOTE: i could templatize this function, but A) there's no need to, and B) I'd have to put it in the header
-class cell * rand_from_list(std::list<cell *> * fromme) {
+class cell * rand_from_list(std::list<cell *> * fromme, class gamerng * rng) {
 	if (fromme->empty()) { return NULL; } // NOTE: bad if this is supposed to return an iterator!!
-	int f = rand() % fromme->size();
+	int f = rng->bounded(fromme->size());
 	std::list<cell *>::iterator iter = fromme->begin();
 	for (int i = 0; i < f; i++) { iter++; } // iterate to this position
 	return *iter;
 }
+// return a random object from the provided set, or NULL if the set is empty... no walking, just index into it
+class cell * rand_from_list(class cellset * fromme, class gamerng * rng) {
+	if (fromme->empty()) { return NULL; }
+	return fromme->at(rng->bounded(fromme->size()));
+}
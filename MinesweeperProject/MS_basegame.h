@@ -7,11 +7,17 @@
 
 #include <cstdlib> // rand, other stuff
 #include <cstdio> // file pointer SUPPOSED to be defined here, but it works even without this? whatever
+#include <cstring> // memcpy
 #include <string> // for print_field
 #include <vector> // used
 #include <list> // used
+#include <algorithm> // used
 #include <cassert> // so it aborts when something wierd happens (but its optimized away in 'release' mode)
 #include <cstdarg> // for variable-arg function-macro
+#include <cstdint> // uint64_t for the bit-planes
+#ifdef _MSC_VER
+#include <intrin.h> // __popcnt64
+#endif
 
 
 
@@ -21,7 +27,7 @@
 // or perhaps make 'runinfo' a member of 'game' object in the same way???
 class runinfo {
 private:
-	int SIZEX; // these 3 can be set only once, but can be read whenever
+	int SIZEX; // these 3 can be set only once (except between -sweep configurations), but can be read whenever
 	int SIZEY;
 	int NUM_MINES;
 public:
@@ -29,12 +35,14 @@ public:
 	runinfo();
 
 	int NUM_GAMES;
-	int SPECIFY_SEED;
+	unsigned long long SPECIFY_SEED;
 	int SCREEN;
 	FILE * logfile;
 
 	// should be called once to set the x/y/mines, but no more than that! don't allow redefinitions
 	void set_gamedata(int newx, int newy, int newmines);
+	// -sweep only: move on to the next configuration's x/y/mines, between batches of games while nothing is being played
+	void change_gamedata(int newx, int newy, int newmines);
 	// read-only accessor
 	inline int get_SIZEX() { return SIZEX; }
 	// read-only accessor
@@ -45,61 +53,340 @@ public:
 extern class runinfo myruninfo;
 
 
-#define MINE 50
+// must fit in the 4-bit 'value' field of a cell, and be bigger than any real adjacency number
+#define MINE 15
 enum cell_state : short {
 	UNKNOWN,			// cell contents are not known
 	SATISFIED,			// all 8 adjacent cells are either flagged or visible; no need to think about this one any more
 	VISIBLE,			// cell has been revealed; hopefully contains an adjacency number
-	FLAGGED				// logically determined to be a mine (but it don't know for sure)
+	FLAGGED,			// logically determined to be a mine (but it don't know for sure)
+	BORDER				// sentinel ring around the field, not part of the game; never matches anything the solver looks for
 };
 
 
 class cell;
 
 
+// count the 1 bits in a word, compiles to the single popcnt instruction
+#ifdef _MSC_VER
+inline int popcount64(uint64_t v) { return (int)__popcnt64(v); }
+#else
+inline int popcount64(uint64_t v) { return __builtin_popcountll(v); }
+#endif
+// index of the lowest 1 bit in a word (the word must not be 0), compiles to the single bsf/tzcnt instruction
+#ifdef _MSC_VER
+inline int ctz64(uint64_t v) { unsigned long i; _BitScanForward64(&i, v); return (int)i; }
+#else
+inline int ctz64(uint64_t v) { return __builtin_ctzll(v); }
+#endif
+
+// which plane is which in the bitboard
+enum bitplane_id {
+	PLANE_MINE,			// cell contains a mine
+	PLANE_VISIBLE,		// cell has been revealed (status VISIBLE or SATISFIED)
+	PLANE_FLAGGED,		// cell has been flagged
+	PLANE_SATISFIED,	// cell has been revealed and has nothing left to say
+	NUM_PLANES
+};
+
+// the board as bit-planes: one bit per cell, each row is 'words' uint64 words wide (exactly 1 word for expert 30x16)
+// cell x,y is bit (x % 64) of word (x / 64) in row y; bits past SIZEX in the last word of a row are always 0
+// whole-row shifts and adds replace the per-cell get_adjacent loops for generation, neighbor counting, and frontier extraction
+class bitboard {
+public:
+	bitboard();
+	// allocate the planes for an x by y field, all zero
+	void init(int x, int y);
+	// zero every plane, start of each game
+	void clear();
+	inline void set(int plane, int x, int y) { planes[plane][(y * words) + (x >> 6)] |= (1ULL << (x & 63)); }
+	inline void clr(int plane, int x, int y) { planes[plane][(y * words) + (x >> 6)] &= ~(1ULL << (x & 63)); }
+	inline bool test(int plane, int x, int y) { return (planes[plane][(y * words) + (x >> 6)] >> (x & 63)) & 1; }
+	// how many of the 8 neighbors of x,y are set in the plane: one popcount over the 3x3 window, minus the center
+	int count_around(const std::vector<uint64_t> & p, int x, int y);
+	inline int count_around(int plane, int x, int y) { return count_around(planes[plane], x, y); }
+	// build the plane of UNKNOWN cells: not visible, not flagged, inside the field
+	void unknown_plane(std::vector<uint64_t> * out);
+	// count the set neighbors of EVERY cell at once, the count is bit-sliced across 4 planes: n = sum[0] + 2*sum[1] + 4*sum[2] + 8*sum[3]
+	void neighbor_sum(const std::vector<uint64_t> & p);
+	// grow every set bit into its 3x3 neighborhood, 'out' must not be 'p'
+	void dilate(const std::vector<uint64_t> & p, std::vector<uint64_t> * out);
+	// same, but only rows ylo-yhi of 'out' are written, and rows of 'p' outside that band are treated as empty
+	void dilate(const std::vector<uint64_t> & p, std::vector<uint64_t> * out, int ylo, int yhi);
+	// frontier: visible, not satisfied, and touching at least one unknown cell (= dilated unknown plane)
+	void frontier_plane(std::vector<uint64_t> * out);
+	// index of the next set bit at or after x,y in reading order, as y*SIZEX+x, or -1 if there are none
+	int next_set(const std::vector<uint64_t> & p, int from);
+
+	int width;
+	int height;
+	int words; // uint64 words per row
+	std::vector<uint64_t> planes[NUM_PLANES];
+	std::vector<uint64_t> sum[4]; // output of neighbor_sum, stays valid until the next call
+private:
+	uint64_t lastmask; // the valid bits of the last word of each row
+	std::vector<uint64_t> scratch; // reused between calls so the queries never allocate
+	// the row shifted so each bit holds its LEFT (x-1) neighbor's bit, or RIGHT (x+1) neighbor's bit
+	inline uint64_t from_left(const uint64_t * row, int w) { return (row[w] << 1) | ((w > 0) ? (row[w - 1] >> 63) : 0); }
+	inline uint64_t from_right(const uint64_t * row, int w) { return (row[w] >> 1) | ((w < words - 1) ? (row[w + 1] << 63) : 0); }
+	// the 3 bits x-1,x,x+1 of one row, packed into the low 3 bits, off-field bits are 0
+	inline unsigned int window3(const uint64_t * row, int x);
+};
+
+
+// counter-based random number generator (Philox4x32-10, Salmon et al. 2011), owned by the game instead of the global rand()
+// output block N is just a pure function of (key, N), so there is no hidden state to share between threads, any game can be
+// regenerated on any machine, and skipping ahead is just adding to the counter. same numbers on every platform, unlike rand()
+class gamerng {
+public:
+	gamerng();
+	// start game number 'gameidx' of a run: key = run seed, and the game index is the high half of the counter, so every game
+	// of the run is its own stream with nothing in between to collide (no seed gets squeezed down to fewer bits on the way)
+	void seed(uint64_t runseed, uint64_t gameidx);
+	// skip ahead by n outputs without computing them
+	void skip(uint64_t n);
+	// next raw 32-bit output
+	uint32_t next();
+	// uniform int in [0, n), without the modulo bias of rand() % n (Lemire's multiply-and-reject method)
+	uint32_t bounded(uint32_t n);
+	// one raw Philox block, for things that want random access instead of a stream (the infinite-mode chunks)
+	// callers must set the top bit of counter_hi, the game streams have it clear
+	static void block(uint64_t seed, uint64_t counter_lo, uint64_t counter_hi, uint32_t out[4]);
+private:
+	uint32_t key[2];
+	uint64_t stream; // the game index, high half of the counter
+	uint64_t ctr; // which block is next, low half of the counter
+	uint32_t buf[4]; // the current block's 4 outputs
+	int bufpos; // how many of 'buf' have been used, 4 = need a new block
+	// the actual Philox4x32 function: 10 rounds of multiply/xor over the counter, with the key bumped between rounds
+	static void philox(const uint32_t k[2], uint64_t counter_lo, uint64_t counter_hi, uint32_t out[4]);
+};
+
+
+// dense indexed set of cell pointers, replaces the old std::list for the unklist/zerolist
+// 'items' is packed tightly, and 'pos' maps each cell (by its index in the field) to its spot in 'items', or -1 if absent
+// so add/remove/contains/size/random-pick are all O(1)... removal swaps the last item into the hole, so order is NOT kept
+class cellset {
+public:
+	cellset();
+	// size the position array for a field of 'fieldsize' cells starting at 'newbase', and empty the set
+	void init(class cell * newbase, int fieldsize);
+	// read-only accessor
+	inline int size() { return (int)items.size(); }
+	// read-only accessor
+	inline bool empty() { return items.empty(); }
+	// read-only accessor, first item in the set (NOT the lowest cell, order is not kept)
+	inline class cell * front() { return items.front(); }
+	// read-only accessor, get the n-th item in the set
+	inline class cell * at(int n) { return items[n]; }
+	inline std::vector<class cell *>::iterator begin() { return items.begin(); }
+	inline std::vector<class cell *>::iterator end() { return items.end(); }
+	// is this cell currently in the set?
+	inline bool contains(class cell * c);
+	// add a cell to the set, does nothing if it is already there
+	inline void push_back(class cell * c);
+	// remove a cell from the set by swapping the last item into its place, does nothing if it isn't there
+	inline void remove(class cell * c);
+	// empty the set, only touches the positions of the items that were in it
+	void clear();
+	// bulk-load an EMPTY set with these cells (no duplicates allowed), skips the one-at-a-time membership checks
+	void fill(const std::vector<class cell *> & src);
+	// make this set a copy of another set over the same field, same item order; only touches the positions of the items
+	// (re-sizes itself first if it was last used on a different field)
+	void copy_from(const class cellset & src);
+private:
+	std::vector<class cell *> items;
+	std::vector<int> pos;
+	class cell * base;
+};
+
+
+// fixed-capacity list of the (at most 8) neighbors of a cell, lives on the stack so building one never allocates
+// filled by game::get_adjacent and game::filter_adjacent, same order as the vector versions
+struct adjlist {
+	class cell * c[8];
+	int n;
+	adjlist() { n = 0; }
+	inline int size() const { return n; }
+	inline bool empty() const { return (n == 0); }
+	inline void clear() { n = 0; }
+	inline void push_back(class cell * foo) { c[n++] = foo; }
+	inline class cell * operator[](int i) const { return c[i]; }
+	inline class cell * const * begin() const { return c; }
+	inline class cell * const * end() const { return c + n; }
+};
+
+
+// what the cell returns when the solver asks about something it isn't allowed to see
+#define HIDDEN_CELL 100
+// read-only view of the board as a player sees it, for the solver's hot loops: plain arrays indexed same as game::field
+// the game only writes a cell's numbers into the arrays once it is revealed, so hidden cells are masked at the source
+// and reading them needs no status check or cheat message (get_value/get_effective still do the check, for everyone else)
+struct boardview {
+	const unsigned char * value; // adjacency number of revealed cells, HIDDEN_CELL for everything else
+	const unsigned char * effective; // 'effective' value of revealed cells, HIDDEN_CELL for everything else
+	const class cell * base; // &field[0], to turn cell pointers into indexes
+	// same results as cell::get_value/get_effective for VISIBLE cells, HIDDEN_CELL for unrevealed ones
+	inline int value_of(const class cell * c) const;
+	inline int effective_of(const class cell * c) const;
+};
+
+
+// a freshly generated board, saved so it can be played again from the very start (-paired plays each board once per mode)
+// the mines are all it takes to rebuild the board, and the rng is saved right after they were placed, so a replay's
+// random guesses draw the same numbers as the first time
+struct boardsnapshot {
+	std::vector<uint64_t> mines; // the mine bit-plane
+	class gamerng rng;
+};
+// place NUM_MINES mines into an all-zero mine plane ('words' uint64s per row) with Floyd's algorithm, drawing from 'rng'
+void place_mines(class gamerng * rng, std::vector<uint64_t> * plane, int words);
+// generate the board for this game without any game object (so any thread can do it): exactly the mines and rng state that
+// reset_for_game would have after rng.seed(runseed, gameidx), ready to be played with reset_for_game(out)
+void generate_board(uint64_t runseed, uint64_t gameidx, struct boardsnapshot * out);
+
+
 // holds the essential structure and some fundamental functions for playing minesweeper code-wise with no UI
 // has some private settings to cell contents can be read only when visible, etc, ensure no cheating!
 class game {
 private:
 	unsigned int mines_remaining; // can be read but not written
+	// running counters for win validation, updated by reveal/set_flag so nobody has to scan the field
+	int correct_flags; // flags placed on mines
+	int incorrect_flags; // flags placed on non-mines (set_flag refuses these, so it should stay 0)
+	int unrevealed_safe; // non-mine cells not yet revealed
+	std::vector<uint64_t> frontier_bits; // reused by get_frontier
+	std::vector<class cell *> flood_stack; // reused by reveal, the to-do stack for zero cascades
+	// worklists as bit-planes: one bit for every cell revealed or flagged since the solver last looked around it
+	// each also keeps the span of rows that have any dirty bits (lo > hi means clean), so a round on a huge field only
+	// touches the rows near where something happened
+	std::vector<uint64_t> singlecell_dirty;
+	std::vector<uint64_t> twocell_dirty;
+	int singlecell_lo, singlecell_hi;
+	int twocell_lo, twocell_hi;
+	std::vector<uint64_t> round_bits, round_tmp; // reused by get_worklist_round
+	// the pass in progress: cells revealed or flagged during it also go in 'pass_new', and next_in_round grows their reach
+	// into 'round_grow', so a cell further along in reading order gets looked at in this same pass (like the old full-field
+	// scans did) instead of waiting for the next one
+	std::vector<uint64_t> pass_new, round_grow;
+	int pass_lo, pass_hi; // the span of rows with bits in pass_new (lo > hi means none)
+	int grow_lo, grow_hi; // same for round_grow
+	int pass_reach; // the reach of the pass in progress (1 single-cell, 3 two-cell)
+	int pass_cursor; // where the pass is, as y*SIZEX+x of the last cell handed out
+	// backing store for 'view', written by reveal/set_flag only for revealed cells
+	std::vector<unsigned char> vis_value;
+	std::vector<unsigned char> vis_effective;
+	// update the neighborhood summaries/frontier/border when 'me' stops being UNKNOWN, called by reveal and set_flag
+	void leave_unknown(class cell * me, bool revealed);
+	// set this cell's bit in both worklists, called whenever a cell is revealed or flagged
+	inline void mark_dirty(int xxx, int yyy) {
+		int w = (yyy * bits.words) + (xxx >> 6); uint64_t b = 1ULL << (xxx & 63);
+		singlecell_dirty[w] |= b; twocell_dirty[w] |= b;
+		if (yyy < singlecell_lo) { singlecell_lo = yyy; }
+		if (yyy > singlecell_hi) { singlecell_hi = yyy; }
+		if (yyy < twocell_lo) { twocell_lo = yyy; }
+		if (yyy > twocell_hi) { twocell_hi = yyy; }
+		pass_new[w] |= b;
+		if (yyy < pass_lo) { pass_lo = yyy; }
+		if (yyy > pass_hi) { pass_hi = yyy; }
+	}
+	// empty one worklist into 'out': every VISIBLE cell within 'reach' steps of a dirty cell, in reading order
+	void get_worklist_round(std::vector<uint64_t> * dirty, int * lo, int * hi, int reach, std::vector<class cell *> * out);
+	// true if one worklist has any bit set within 'reach' steps of x,y
+	bool dirty_near(const std::vector<uint64_t> & dirty, int lo, int hi, int xxx, int yyy, int reach);
 public:
 	// empty constructor: with no args, don't do much
 	game();
 	// init: with args, allocate the field to be the proper size
 	int init(int x, int y);
 
-	std::list<class cell *> zerolist; // zero-list, probably should be private but I dont care to figure it out
-	std::list<class cell *> unklist; // unknown-list, hopefully allows for faster "better rand"
-	std::vector<std::vector<class cell>> field; // the actual playing field; overwritten for each game
-	std::vector<std::vector<class cell>> field_blank; // a blank field, easier to copy this onto actual than to erase & rebuild
+	class cellset zerolist; // zero-list, probably should be private but I dont care to figure it out
+	class cellset unklist; // unknown-list, indexed so remove and "better rand" are both O(1)
+	// live summaries, kept up to date by reveal/set_flag so the solver never has to rebuild them
+	class cellset frontier; // VISIBLE cells with at least 1 unknown neighbor, the roots of the pods (order is not kept)
+	class cellset border; // UNKNOWN cells next to at least 1 revealed cell, the contents of the pods; unklist - border = interior
+	// the actual playing field, one contiguous block in reading order; overwritten for each game
+	// it is padded with a ring of BORDER cells, so every real cell has 8 neighbors in memory and no bounds check is needed
+	std::vector<class cell> field;
+	std::vector<class cell> field_blank; // a blank field, easier to copy this onto actual than to erase & rebuild
+	int stride; // distance between vertically adjacent cells in 'field', = SIZEX + 2
+	int adj_offset[8]; // pointer offsets to the 8 neighbors, in the same order that get_adjacent has always used
+	std::vector<unsigned char> adj_mask; // per-cell neighbor table, bit i set if (me + adj_offset[i]) is a real cell and not BORDER
+	std::vector<unsigned char> adj_count; // per-cell neighbor table, how many real neighbors (3/5/8)
+	std::vector<class cell *> all_cells; // every real cell in reading order, for bulk-loading the unklist
+	// per-cell neighborhood summaries, indexed same as 'field', kept up to date by reveal/set_flag
+	// NOTE: neighbor i of me sees me as ITS neighbor 7-i, because the offsets are symmetric
+	std::vector<unsigned char> unk_count; // how many of the 8 neighbors are UNKNOWN
+	std::vector<unsigned char> unk_mask; // bit i set if (me + adj_offset[i]) is UNKNOWN
+	std::vector<unsigned char> vis_count; // how many of the 8 neighbors have been revealed
+	class bitboard bits; // bit-plane copy of the mine/visible/flagged/satisfied state, kept in sync with the cells
+	class gamerng rng; // this game's private random stream, seed it before reset_for_game
+	struct boardview view; // read-only view of the revealed numbers, set up in init; the pointers never change after that
 
 	// read-only accessor
 	inline unsigned int get_mines_remaining() { return mines_remaining; }
+	// return cell pointer for x and y WITHOUT checking the field size, use only when x and y are known to be valid
+	inline class cell * cellat(int xxx, int yyy) { return &field[((yyy + 1) * stride) + (xxx + 1)]; }
+	// the coordinates of a cell in the field, cells don't store them so they come from the cell's position in 'field'
+	inline int xof(class cell * me);
+	inline int yof(class cell * me);
 	// checks x and y against field size; if valid, return cell pointer. if invalid, return NULL
 	class cell * cellptr(int xxx, int yyy);
-	// return a vector of the 3/5/8 cells surrounding the target
+	// fill 'out' with the 3/5/8 cells surrounding the target, from the neighbor table; doesn't allocate
+	void get_adjacent(class cell * me, struct adjlist * out);
+	// fill 'out' with only the surrounding cells of the given state; doesn't allocate
+	void filter_adjacent(class cell * me, cell_state target, struct adjlist * out);
+	// fill 'out' with only the cells of 'adj' that have the given state; doesn't allocate
+	void filter_adjacent(const struct adjlist & adj, cell_state target, struct adjlist * out);
+	// compatibility wrapper: return a vector of the 3/5/8 cells surrounding the target
 	std::vector<class cell *> get_adjacent(class cell * me);
-	// basically the same as get_adjacent but returns only cells of the given state
+	// compatibility wrapper: basically the same as get_adjacent but returns only cells of the given state
 	std::vector<class cell *> filter_adjacent(class cell * me, cell_state target);
-	// basically the same as get_adjacent but returns only cells of the given state
-	std::vector<class cell *> filter_adjacent(std::vector<class cell *> adj, cell_state target);
+	// compatibility wrapper: basically the same as get_adjacent but returns only cells of the given state
+	std::vector<class cell *> filter_adjacent(const std::vector<class cell *> & adj, cell_state target);
+	// how many of the 8 neighbors are FLAGGED, from the bit-planes
+	int count_flagged_around(class cell * me);
+	// how many of the 8 neighbors are UNKNOWN, O(1) from the live summary
+	inline int count_unknown_around(class cell * me);
+	// fill 'out' with the frontier: VISIBLE (not satisfied) cells that touch at least one UNKNOWN cell, in reading order
+	void get_frontier(std::vector<class cell *> * out);
+	// sets cell status to SATISFIED, and keeps the bit-planes in sync
+	void set_satisfied(class cell * me);
+	// the cells single-cell logic needs to look at: VISIBLE cells touching anything revealed or flagged since the last round
+	// (only those cells' effective value or unknown neighbors can have changed) in reading order, and empties the worklist
+	void get_singlecell_round(std::vector<class cell *> * out);
+	// the cells two-cell logic needs to look at: it compares a center against cells in its 5x5, so this is every VISIBLE cell
+	// within 3 of anything revealed or flagged since the last round, in reading order, and empties the worklist
+	void get_twocell_round(std::vector<class cell *> * out);
+	// walk the pass that get_singlecell_round/get_twocell_round just started: the next cell in reading order that is either
+	// the next one left in 'round' (from *i on) or within reach of something revealed or flagged earlier in this pass
+	// *k is set to its index in 'round', or -1 if it only came in partway through; returns NULL once the pass is done
+	class cell * next_in_round(const std::vector<class cell *> & round, int * i, int * k);
+	// true if anything close enough to change this cell's single-cell/two-cell result has been revealed or flagged since that
+	// round was handed out; lets the tiled logic trust a verdict it worked out in parallel at the start of the round
+	bool singlecell_changed_near(class cell * me);
+	bool twocell_changed_near(class cell * me);
 
 	// uncovers the target cell, turning it from UNKNOWN to VISIBLE. also calculates the 'effective' value of the freshly-revealed cell
-	// remove it from the unklist, and if it's a zero, remove it from the zero-list and recurse!
+	// remove it from the unklist, and if it's a zero, remove it from the zero-list and flood-fill outward (no recursion)!
 	// returns -1 if the cell was a mine (GAME LOSS), or the # of cells revealed otherwise
 	int reveal(class cell * me);
 	// sets cell state to FLAGGED, reduces # remaining mines, reduce "effective" values of everything visible around it
-	// also checks if the game was won as a result
+	// also checks if the game was won as a result, using the running counters (O(1))
 	// return -1=win, 0=nothing happened (target already flagged), 1=flagged a cell, 2=flagged a non-mine cell
 	int set_flag(class cell * me);
 	// print: either 1) fully-revealed field, 2) in-progress field as seen by human, 3) in-progress field showing 'effective' values
 	// borders made with +, zeros= blank, adjacency (or effective)= number, unknown= -, flag or mine= *
 	// if SCREEN=0, don't print anything. if SCREEN=1, print to log. if SCREEN=2, print to both.
 	void print_field(int mode, int screen);
-	// reset the field, place new mines, set 'value' for non-mine cells, clear and repopulate the lists, etc
+	// reset the field, place new mines (Floyd's sampling, exactly NUM_MINES draws at any density), set 'value' for non-mine
+	// cells (all at once from the mine bit-plane), clear and repopulate the lists, etc
 	// returns the number of 8-cells found when generating (just because I can)
 	// also prints the fully-revealed field after doing all this
-	int reset_for_game();
+	// if 'replay' is given, the mines and the rng come from that snapshot instead, to play the same board over again
+	int reset_for_game(const struct boardsnapshot * replay = NULL);
+	// save the board that reset_for_game just set up, before any moves are made on it
+	void save_board(struct boardsnapshot * out);
 };
 
 
@@ -109,29 +396,59 @@ public:
 // the solver can set the cell state to SATISFIED, and read the state variable, but only the friends can set it to FLAGGED or VISIBLE
 class cell {
 private:
-	cell_state status;
-	short unsigned int effective;
-	//short unsigned int value; // TODO: implement bias function and make this private again
+	// packed into 16 bits total: a full row of an expert field is ~1 cache line
+	// all the same underlying type so MSVC packs them into the same unsigned short
+	// SATISFIED is a status of its own so no separate bit is needed
+	short unsigned int status : 3; // really a cell_state, but a 3-bit unsigned field so BORDER=4 doesn't come back negative
+	short unsigned int effective : 4; // MINE=15 is the biggest it ever holds
+	//short unsigned int value : 4; // TODO: implement bias function and make this private again
 public:
-	short unsigned int value; // TODO: made this public for smartguess_diff stat only
+	short unsigned int value : 4; // TODO: made this public for smartguess_diff stat only
 	cell();
-	short unsigned int x, y;
 	// read-only conditional accessor, only works if status == VISIBLE
 	short unsigned int get_value();
 	// read-only conditional accessor, only works if status == VISIBLE
 	short unsigned int get_effective();
 	// read-only accessor
-	inline cell_state get_status() { return status; }
-	// sets cell status to SATISFIED
-	inline void set_status_satisfied() { status = SATISFIED; }
+	inline cell_state get_status() { return (cell_state)status; }
 
+	friend int game::init(int x, int y);
 	friend int game::reveal(class cell * me);
 	friend int game::set_flag(class cell * me);
 	friend void game::print_field(int mode, int screen);
-	friend int game::reset_for_game();
+	friend int game::reset_for_game(const struct boardsnapshot * replay);
+	friend void game::set_satisfied(class cell * me);
 };
 
 
+static_assert(sizeof(class cell) == 2, "cell is supposed to pack into 16 bits");
+
+
+// game/cellset members that need to know the size of a cell (pointer math), so they go after the cell definition
+inline int game::count_unknown_around(class cell * me) { return unk_count[me - &field[0]]; }
+inline int boardview::value_of(const class cell * c) const { return value[c - base]; }
+inline int boardview::effective_of(const class cell * c) const { return effective[c - base]; }
+inline int game::xof(class cell * me) { return (int)((me - &field[0]) % stride) - 1; }
+inline int game::yof(class cell * me) { return (int)((me - &field[0]) / stride) - 1; }
+inline bool cellset::contains(class cell * c) { return pos[c - base] >= 0; }
+inline void cellset::push_back(class cell * c) {
+	int idx = (int)(c - base);
+	if (pos[idx] >= 0) { return; }
+	pos[idx] = (int)items.size();
+	items.push_back(c);
+}
+inline void cellset::remove(class cell * c) {
+	int idx = (int)(c - base);
+	int p = pos[idx];
+	if (p < 0) { return; }
+	class cell * last = items.back();
+	items[p] = last; // fill the hole with the last item (harmless if it IS the last item)
+	pos[last - base] = p;
+	items.pop_back();
+	pos[idx] = -1;
+}
+
+
 
 
 
@@ -146,9 +463,13 @@ bool sort_cells(class cell * a, class cell * b);
 // extract_overlap: takes two vectors of cells, returns (first_vect_unique) (second_vect_unique) (overlap)
 // NOTE: i could templatize this function, but A) there's no need to, and B) I'd have to put it in the header
 std::vector<std::vector<class cell *>> extract_overlap(std::vector<class cell *> me_unk, std::vector<class cell *> other_unk);
+// extract_overlap for neighbor lists: same outputs in the same order, but written into caller-provided lists so nothing is allocated
+void extract_overlap(const struct adjlist & me_unk, const struct adjlist & other_unk, struct adjlist * me_only, struct adjlist * other_only, struct adjlist * overlap);
 // return a random object from the provided list, or NULL if the list is empty
 // NOTE: i could templatize this function, but A) there's no need to, and B) I'd have to put it in the header
-class cell * rand_from_list(std::list<cell *> * fromme);
+class cell * rand_from_list(std::list<cell *> * fromme, class gamerng * rng);
+// return a random object from the provided set, or NULL if the set is empty... no walking, just index into it
+class cell * rand_from_list(class cellset * fromme, class gamerng * rng);
 
 
 
@@ -0,0 +1,269 @@
+// the board for "infinite" mode: chunks generated on demand, compressed once finished, mine planes cached LRU
+
+
+
+#include "MS_settings.h"
+#include "MS_chunkgame.h" // include myself
+#include <algorithm> // nth_element for the LRU
+
+
+
+// basic constructor
+chunkgame::chunkgame() {
+	reset_for_game(0, 0, 0.);
+}
+// start game number 'gameidx' of a run: forget every chunk and set the seed and mine density (0-1)
+void chunkgame::reset_for_game(uint64_t runseed, uint64_t gameidx, double density) {
+	assert((gameidx >> 47) == 0); // has to fit in the counter under the top bit, next to the 16 bits of cell number
+	seed = runseed;
+	game = gameidx;
+	if (density <= 0.) { mine_threshold = 0; }
+	else if (density >= 1.) { mine_threshold = 0xFFFFFFFF; }
+	else { mine_threshold = (uint32_t)(density * 4294967296.); }
+	clock = 0;
+	active.clear();
+	finished.clear();
+	minecache.clear();
+	last_mines = NULL; last_state = NULL;
+	changed.clear();
+	flood_stack.clear();
+	focus_cx = 0; focus_cy = 0;
+	revealed = 0;
+	flags = 0;
+	incorrect_flags = 0;
+	chunks_generated = 0;
+	forgets = 0;
+	extra_bytes = 0;
+	bytes_peak = 0;
+}
+
+// fill in one chunk's mine plane from the seed: one Philox block per 4 cells, keyed by the run seed with the chunk key
+// and (game, which 4 cells) as the counter, so any chunk can be built (or rebuilt) on its own, in any order, and always
+// comes out the same
+// the 3x3 around 0,0 is never mined, that's where the game starts (guaranteed zero, like -findz)
+void chunkgame::generate(uint64_t key, struct chunkmines * out) {
+	int cx = (int)(uint32_t)(key >> 32); int cy = (int)(uint32_t)key;
+	uint32_t blk[4];
+	for (int r = 0; r < CHUNK_SIZE; r++) {
+		uint32_t row = 0;
+		for (int b = 0; b < CHUNK_SIZE; b += 4) {
+			gamerng::block(seed, key, (1ULL << 63) | (game << 16) | (uint64_t)(((r * CHUNK_SIZE) + b) / 4), blk);
+			for (int i = 0; i < 4; i++) {
+				if (blk[i] < mine_threshold) { row |= (1u << (b + i)); }
+			}
+		}
+		int gy = (cy * CHUNK_SIZE) + r;
+		if ((gy >= -1) && (gy <= 1)) {
+			for (int gx = -1; gx <= 1; gx++) {
+				if ((gx >> CHUNK_BITS) == cx) { row &= ~(1u << (gx & CHUNK_MASK)); }
+			}
+		}
+		out->mine[r] = row;
+	}
+	chunks_generated++;
+}
+// drop the older half of the mine cache once it gets too big; they'll be regenerated if anything needs them again
+void chunkgame::evict_mines() {
+	std::vector<std::pair<uint64_t, uint64_t>> ages; // last_used, key
+	ages.reserve(minecache.size());
+	for (std::unordered_map<uint64_t, struct chunkmines>::iterator it = minecache.begin(); it != minecache.end(); it++) {
+		ages.push_back(std::pair<uint64_t, uint64_t>(it->second.last_used, it->first));
+	}
+	std::nth_element(ages.begin(), ages.begin() + (ages.size() / 2), ages.end());
+	for (int i = 0; i < (int)ages.size() / 2; i++) {
+		minecache.erase(ages[i].second);
+	}
+	last_mines = NULL;
+}
+// get this chunk's mine plane, generating it if it isn't in the cache
+struct chunkmines * chunkgame::mines_of(int x, int y) {
+	uint64_t key = key_of(x, y);
+	clock++;
+	if ((last_mines != NULL) && (last_mines_key == key)) { last_mines->last_used = clock; return last_mines; }
+	std::unordered_map<uint64_t, struct chunkmines>::iterator it = minecache.find(key);
+	if (it == minecache.end()) {
+		if (minecache.size() >= INFINITE_MINE_CACHE) { evict_mines(); }
+		it = minecache.insert(std::pair<uint64_t, struct chunkmines>(key, chunkmines())).first;
+		generate(key, &it->second);
+		track_peak(extra_bytes);
+	}
+	it->second.last_used = clock;
+	last_mines_key = key; last_mines = &it->second;
+	return last_mines;
+}
+// get this chunk's state, making an empty one if it is untouched; NULL if it is finished
+struct chunkstate * chunkgame::state_of(int x, int y) {
+	uint64_t key = key_of(x, y);
+	if ((last_state != NULL) && (last_state_key == key)) { return last_state; }
+	std::unordered_map<uint64_t, struct chunkstate>::iterator it = active.find(key);
+	if (it == active.end()) {
+		if (finished.count(key)) { return NULL; }
+		struct chunkstate blank;
+		memset(&blank, 0, sizeof(blank));
+		it = active.insert(std::pair<uint64_t, struct chunkstate>(key, blank)).first;
+	}
+	last_state_key = key; last_state = &it->second;
+	return last_state;
+}
+// move the window to this cell's chunk, and if too many chunks are stored, forget everything outside it
+// forgetting only happens once the stored chunks reach twice the window, so it is rare and each pass is cheap per chunk
+void chunkgame::set_focus(int x, int y) {
+	focus_cx = x >> CHUNK_BITS; focus_cy = y >> CHUNK_BITS;
+	int side = (2 * INFINITE_KEEP_RADIUS) + 1;
+	if ((int)(active.size() + finished.size()) <= 2 * side * side) { return; }
+	for (std::unordered_map<uint64_t, struct chunkstate>::iterator it = active.begin(); it != active.end(); ) {
+		if (in_window((int)(uint32_t)(it->first >> 32) << CHUNK_BITS, (int)(uint32_t)it->first << CHUNK_BITS)) { it++; }
+		else { it = active.erase(it); }
+	}
+	for (std::unordered_set<uint64_t>::iterator it = finished.begin(); it != finished.end(); ) {
+		if (in_window((int)(uint32_t)(*it >> 32) << CHUNK_BITS, (int)(uint32_t)(*it) << CHUNK_BITS)) { it++; }
+		else { it = finished.erase(it); }
+	}
+	int keep = 0;
+	for (int i = 0; i < (int)changed.size(); i++) {
+		if (in_window(changed[i].first, changed[i].second)) { changed[keep++] = changed[i]; }
+	}
+	changed.resize(keep);
+	last_state = NULL;
+	forgets++;
+}
+// is this cell's chunk inside the window?
+bool chunkgame::in_window(int x, int y) {
+	return (abs((x >> CHUNK_BITS) - focus_cx) <= INFINITE_KEEP_RADIUS) && (abs((y >> CHUNK_BITS) - focus_cy) <= INFINITE_KEEP_RADIUS);
+}
+bool chunkgame::is_mine(int x, int y) {
+	return (mines_of(x, y)->mine[y & CHUNK_MASK] >> (x & CHUNK_MASK)) & 1;
+}
+// if this chunk is completely open, throw away its state and remember only that it is finished
+// a chunk with a wrong flag stays active, "finished" means its state can be rebuilt from the mines alone
+void chunkgame::try_compress(int x, int y) {
+	struct chunkstate * s = state_of(x, y);
+	if ((s == NULL) || (s->open != CHUNK_SIZE * CHUNK_SIZE)) { return; }
+	struct chunkmines * m = mines_of(x, y);
+	for (int r = 0; r < CHUNK_SIZE; r++) {
+		if (s->flagged[r] != m->mine[r]) { return; }
+	}
+	active.erase(key_of(x, y));
+	finished.insert(key_of(x, y));
+	last_state = NULL;
+}
+// memory in use right now, in bytes: every chunk table, the mine cache, the flood stack and 'changed', plus the player's
+size_t chunkgame::bytes_now() {
+	return hash_table_bytes(active) + hash_table_bytes(finished) + hash_table_bytes(minecache) +
+		(flood_stack.capacity() * sizeof(flood_stack[0])) + (changed.capacity() * sizeof(changed[0])) + extra_bytes;
+}
+// the most bytes_now has been this game; the player calls this with its own total whenever that might have grown
+void chunkgame::track_peak(size_t extra) {
+	extra_bytes = extra;
+	size_t b = bytes_now();
+	if (b > bytes_peak) { bytes_peak = b; }
+}
+
+
+
+// read-only accessor, status of one cell (UNKNOWN, VISIBLE, or FLAGGED)
+cell_state chunkgame::get_status(int x, int y) {
+	uint64_t key = key_of(x, y);
+	struct chunkstate * s = NULL;
+	if ((last_state != NULL) && (last_state_key == key)) {
+		s = last_state;
+	} else {
+		std::unordered_map<uint64_t, struct chunkstate>::iterator it = active.find(key);
+		if (it != active.end()) {
+			s = &it->second;
+		} else if (finished.count(key)) {
+			return is_mine(x, y) ? FLAGGED : VISIBLE;
+		} else {
+			return UNKNOWN; // untouched, and looking at it doesn't create it
+		}
+	}
+	int r = y & CHUNK_MASK; int b = x & CHUNK_MASK;
+	if ((s->visible[r] >> b) & 1) { return VISIBLE; }
+	if ((s->flagged[r] >> b) & 1) { return FLAGGED; }
+	return UNKNOWN;
+}
+// read-only conditional accessor, only works if the cell is VISIBLE
+int chunkgame::get_value(int x, int y) {
+	if (get_status(x, y) != VISIBLE) { myprintfn(2, "HEY! NO CHEATING! Can't peek at cell contents!\n"); return HIDDEN_CELL; }
+	int v = 0;
+	for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+		if ((a == 0) && (b == 0)) { continue; }
+		v += is_mine(x + a, y + b);
+	}}
+	return v;
+}
+// value minus the flags around it, only works if the cell is VISIBLE
+int chunkgame::get_effective(int x, int y) {
+	int v = get_value(x, y);
+	if (v == HIDDEN_CELL) { return v; }
+	for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+		if ((a == 0) && (b == 0)) { continue; }
+		v -= (get_status(x + a, y + b) == FLAGGED);
+	}}
+	return v;
+}
+// how many of the 8 neighbors are UNKNOWN
+int chunkgame::count_unknown_around(int x, int y) {
+	int u = 0;
+	for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+		if ((a == 0) && (b == 0)) { continue; }
+		u += (get_status(x + a, y + b) == UNKNOWN);
+	}}
+	return u;
+}
+
+// uncovers the target cell and flood-fills zeros outward with an explicit stack, same as game::reveal
+// cells are claimed (set visible) when pushed, and only while revealed + waiting is under 'budget', so the fill stops
+// exactly at the budget; it also never claims a cell outside the window
+int chunkgame::reveal(int x, int y, long long budget) {
+	if (get_status(x, y) != UNKNOWN) { return 0; }
+	if (revealed >= budget) { return 0; } // out of budget, nothing more gets uncovered
+	set_focus(x, y);
+	if (is_mine(x, y)) { return -1; } // lose the game, handled wherever calls here
+
+	int retme = 0;
+	flood_stack.clear();
+	flood_stack.push_back(std::pair<int, int>(x, y));
+	struct chunkstate * s = state_of(x, y);
+	s->visible[y & CHUNK_MASK] |= (1u << (x & CHUNK_MASK)); s->open++;
+	while (!flood_stack.empty()) {
+		int cx = flood_stack.back().first; int cy = flood_stack.back().second;
+		flood_stack.pop_back();
+		changed.push_back(std::pair<int, int>(cx, cy));
+		retme++;
+		revealed++;
+		try_compress(cx, cy);
+		// a cascade never reaches a mine: it only spreads from zeros
+		int v = 0;
+		for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+			if ((a == 0) && (b == 0)) { continue; }
+			v += is_mine(cx + a, cy + b);
+		}}
+		if (v != 0) { continue; }
+		for (int b = -1; b < 2; b++) { for (int a = -1; a < 2; a++) {
+			if ((a == 0) && (b == 0)) { continue; }
+			if (get_status(cx + a, cy + b) != UNKNOWN) { continue; }
+			if (!in_window(cx + a, cy + b)) { continue; }
+			if (revealed + (long long)flood_stack.size() >= budget) { continue; } // out of budget, don't claim any more
+			s = state_of(cx + a, cy + b);
+			s->visible[(cy + b) & CHUNK_MASK] |= (1u << ((cx + a) & CHUNK_MASK)); s->open++;
+			flood_stack.push_back(std::pair<int, int>(cx + a, cy + b));
+		}}
+	}
+	track_peak(extra_bytes);
+	return retme;
+}
+// sets the cell to FLAGGED, return 0=nothing happened (not UNKNOWN), 1=flagged a mine, 2=flagged a non-mine cell
+// a wrong flag is placed anyway and counted, like game::set_flag; the caller decides what to make of it
+int chunkgame::set_flag(int x, int y) {
+	if (get_status(x, y) != UNKNOWN) { return 0; }
+	set_focus(x, y);
+	struct chunkstate * s = state_of(x, y);
+	s->flagged[y & CHUNK_MASK] |= (1u << (x & CHUNK_MASK)); s->open++;
+	changed.push_back(std::pair<int, int>(x, y));
+	flags++;
+	int retme = 1;
+	if (!is_mine(x, y)) { incorrect_flags++; retme = 2; }
+	try_compress(x, y);
+	return retme;
+}
@@ -0,0 +1,127 @@
+#ifndef MS_CHUNKGAME
+#define MS_CHUNKGAME
+// the board for "infinite" mode: a field with no edges, split into fixed-size chunks that are generated the first time
+// anything looks at them, each from its own deterministic seed, so only the part near the player ever exists in memory
+// everything that grows with the game is kept to a window of chunks around the latest move, so memory stays bounded
+// no matter how big the budget is
+
+
+
+#include <cstdint> // uint32_t rows, uint64_t keys
+#include <vector> // used
+#include <unordered_map> // chunk lookup by chunk coordinates
+#include <unordered_set> // compressed (finished) chunks
+#include "MS_basegame.h" // gamerng, cell_state, popcount64
+
+
+
+// a chunk is CHUNK_SIZE x CHUNK_SIZE cells, so each row of a chunk is exactly one uint32
+#define CHUNK_BITS	5
+#define CHUNK_SIZE	(1 << CHUNK_BITS)
+#define CHUNK_MASK	(CHUNK_SIZE - 1)
+
+
+// the part of a chunk that can't be regenerated: what has been revealed and flagged
+// the mine plane lives separately in the LRU cache, because it can always be rebuilt from the seed
+struct chunkstate {
+	uint32_t visible[CHUNK_SIZE];
+	uint32_t flagged[CHUNK_SIZE];
+	int open; // how many cells are visible or flagged, when this hits CHUNK_SIZE^2 the chunk gets compressed (if its flags are right)
+};
+// one chunk's mine plane, plus when it was last used (for the LRU)
+struct chunkmines {
+	uint32_t mine[CHUNK_SIZE];
+	uint64_t last_used;
+};
+
+
+// same idea as 'game' but unbounded: cells are addressed by x/y (negative is fine), there are no cell objects at all
+// a chunk is in one of 3 forms: untouched (not stored at all, everything UNKNOWN), active (has a chunkstate), or finished
+// (every cell open and every flag on a mine, so its state is exactly "mines flagged, everything else visible" and the
+// chunkstate is thrown away, leaving only its key in 'finished')
+// the window: the (2 * INFINITE_KEEP_RADIUS + 1)^2 chunks around the chunk of the latest reveal/flag. a flood fill never
+// leaves it, and once twice that many chunks are stored, every chunk outside it is forgotten: it goes back to untouched
+// (hidden again, flags and all), and its cells count again if they ever get revealed again
+class chunkgame {
+public:
+	chunkgame();
+	// start game number 'gameidx' of a run: forget every chunk and set the seed and mine density (0-1)
+	void reset_for_game(uint64_t runseed, uint64_t gameidx, double density);
+
+	// read-only accessor, status of one cell (UNKNOWN, VISIBLE, or FLAGGED)
+	cell_state get_status(int x, int y);
+	// read-only conditional accessor, only works if the cell is VISIBLE
+	int get_value(int x, int y);
+	// value minus the flags around it, only works if the cell is VISIBLE
+	int get_effective(int x, int y);
+	// how many of the 8 neighbors are UNKNOWN
+	int count_unknown_around(int x, int y);
+
+	// uncovers the target cell and flood-fills zeros outward (no recursion), within the window around the target and never
+	// past 'budget' total cells revealed: no cell is claimed once that many are revealed or waiting to be
+	// returns -1 if the cell was a mine, or the # of cells revealed (0 if the budget is already spent)
+	int reveal(int x, int y, long long budget);
+	// sets the cell to FLAGGED, return 0=nothing happened (not UNKNOWN), 1=flagged a mine, 2=flagged a non-mine cell
+	// (the flag is placed anyway and counted in incorrect_flags, same as a wrong flag on a normal board)
+	int set_flag(int x, int y);
+
+	// every cell revealed or flagged since the player last emptied this, so it knows where to look next
+	// cells in chunks that get forgotten are taken back out
+	std::vector<std::pair<int, int>> changed;
+	// running totals for this game
+	long long revealed; // cells revealed so far
+	long long flags; // flags placed so far
+	long long incorrect_flags; // flags placed on non-mines
+	long long chunks_generated; // mine planes built, counting rebuilds after eviction
+	long long forgets; // how many times chunks outside the window were forgotten; the player drops its own copies then
+	// memory in use right now, in bytes: every chunk table, the mine cache, the flood stack and 'changed', with the hash
+	// tables' nodes and buckets; plus 'extra', what the player reported for its own structures
+	size_t bytes_now();
+	size_t extra_bytes;
+	// the most bytes_now has been this game; the player calls this with its own total whenever that might have grown
+	void track_peak(size_t extra);
+	size_t bytes_peak;
+
+private:
+	uint64_t seed; // the run seed
+	uint64_t game; // which game of the run, goes into the counter next to the cell's place in the chunk
+	uint32_t mine_threshold; // a cell is a mine if its random 32-bit number is below this
+	uint64_t clock; // LRU timestamp, bumped on every mine-plane lookup
+	int focus_cx, focus_cy; // chunk of the latest reveal/flag, the middle of the window
+	std::unordered_map<uint64_t, struct chunkstate> active;
+	std::unordered_set<uint64_t> finished;
+	std::unordered_map<uint64_t, struct chunkmines> minecache;
+	std::vector<std::pair<int, int>> flood_stack; // reused by reveal
+	// one-entry caches, most lookups land in the same chunk as the one before
+	uint64_t last_mines_key; struct chunkmines * last_mines;
+	uint64_t last_state_key; struct chunkstate * last_state;
+
+	// pack chunk coordinates into one key (arithmetic shift, so negative coords floor like they should)
+	static inline uint64_t key_of(int x, int y) {
+		return ((uint64_t)(uint32_t)(x >> CHUNK_BITS) << 32) | (uint64_t)(uint32_t)(y >> CHUNK_BITS);
+	}
+	// get this chunk's mine plane, generating it if it isn't in the cache
+	struct chunkmines * mines_of(int x, int y);
+	// get this chunk's state, making an empty one if it is untouched; NULL if it is finished
+	struct chunkstate * state_of(int x, int y);
+	// fill in one chunk's mine plane from the seed
+	void generate(uint64_t key, struct chunkmines * out);
+	// drop the older half of the mine cache once it gets too big
+	void evict_mines();
+	// move the window to this cell's chunk, and if too many chunks are stored, forget everything outside it
+	void set_focus(int x, int y);
+	// is this cell's chunk inside the window?
+	bool in_window(int x, int y);
+	// if this chunk is completely open, throw away its state and remember only that it is finished
+	void try_compress(int x, int y);
+	bool is_mine(int x, int y);
+};
+
+// memory held by a std::unordered_map/set: its nodes (the value, the next pointer and the cached hash) plus its buckets
+template <class T> inline size_t hash_table_bytes(const T & t) {
+	return (t.size() * (sizeof(typename T::value_type) + (2 * sizeof(void *)))) + (t.bucket_count() * sizeof(void *));
+}
+
+
+
+#endif
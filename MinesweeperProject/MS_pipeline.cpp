@@ -0,0 +1,84 @@
+// the -pipeline board ring and the producer threads that fill it
+
+
+
+#include <thread> // yield
+
+#include "MS_settings.h"
+#include "MS_basegame.h"
+#include "MS_pipeline.h" // include myself
+
+
+
+// basic constructor: unusable until init
+boardring::boardring() {
+	producing = 0;
+	mask = 0;
+	push_pos = 0;
+	pop_pos = 0;
+}
+// size the ring, must be a power of 2; the slots' boards are allocated once and reused all the way through
+void boardring::init(int capacity) {
+	assert((capacity >= 2) && ((capacity & (capacity - 1)) == 0));
+	slots = std::vector<struct ringslot>(capacity);
+	mask = capacity - 1;
+	for (size_t i = 0; i < slots.size(); i++) { slots[i].seq.store(i, std::memory_order_relaxed); }
+	push_pos = 0;
+	pop_pos = 0;
+}
+// producer: claim the next empty slot to fill in, or NULL if the ring is full; hand it over with end_push
+struct ringslot * boardring::try_push() {
+	size_t pos = push_pos.load(std::memory_order_relaxed);
+	while (true) {
+		struct ringslot * s = &slots[pos & mask];
+		size_t seq = s->seq.load(std::memory_order_acquire);
+		intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+		if (dif == 0) {
+			// my turn on this slot, if nobody else claims it first
+			if (push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { s->pos = pos; return s; }
+		} else if (dif < 0) {
+			return NULL; // the consumer hasn't emptied it yet from the last lap: full
+		} else {
+			pos = push_pos.load(std::memory_order_relaxed); // someone else got it, try the next one
+		}
+	}
+}
+void boardring::end_push(struct ringslot * s) {
+	s->seq.store(s->pos + 1, std::memory_order_release); // now it's the consumer's turn
+}
+// consumer: claim the next ready board, or NULL if there isn't one yet; give the slot back with end_pop once done reading
+struct ringslot * boardring::try_pop() {
+	size_t pos = pop_pos.load(std::memory_order_relaxed);
+	while (true) {
+		struct ringslot * s = &slots[pos & mask];
+		size_t seq = s->seq.load(std::memory_order_acquire);
+		intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+		if (dif == 0) {
+			if (pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { s->pos = pos; return s; }
+		} else if (dif < 0) {
+			return NULL; // not filled yet: empty
+		} else {
+			pos = pop_pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+void boardring::end_pop(struct ringslot * s) {
+	s->seq.store(s->pos + mask + 1, std::memory_order_release); // empty again, for the producer on the next lap
+}
+
+
+
+// producer thread: take game indices from 'next_game' until 'end_game', generate each board and put it in the ring
+// waits (yielding the core) while the ring is full; decrements ring->producing when done
+void produce_boards(unsigned long long runseed, std::atomic<int> * next_game, int end_game, class boardring * ring) {
+	while (true) {
+		int game = next_game->fetch_add(1);
+		if (game >= end_game) { break; }
+		struct ringslot * s;
+		while ((s = ring->try_push()) == NULL) { std::this_thread::yield(); } // the solvers are behind, wait for room
+		s->game = game;
+		generate_board(runseed, game, &s->snap);
+		ring->end_push(s);
+	}
+	ring->producing.fetch_sub(1, std::memory_order_release);
+}
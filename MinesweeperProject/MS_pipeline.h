@@ -0,0 +1,63 @@
+#ifndef MS_PIPELINE
+#define MS_PIPELINE
+// -pipeline: boards are generated ahead of time by producer threads and handed to the game-playing threads through a
+// bounded lock-free ring, so the seeding and mine placement overlap with solving instead of sitting in front of every game
+
+
+
+#include <vector> // used
+#include <atomic> // the ring positions and sequence numbers
+#include <cstddef> // size_t
+#include <cstdint> // intptr_t
+
+#include "MS_basegame.h" // boardsnapshot
+
+
+
+// one slot of the ring, holding a board that's ready to play: which game it is, and its mines and rng state
+struct ringslot {
+	std::atomic<size_t> seq; // == pos: empty and it's a producer's turn; == pos+1: full and it's a consumer's turn
+	size_t pos; // the position it was claimed at, so end_push/end_pop know what comes next
+	int game;
+	struct boardsnapshot snap;
+};
+
+
+// bounded multi-producer multi-consumer ring of ready boards (Dmitry Vyukov's design): each slot has a sequence number
+// that says whose turn it is, so a producer or consumer claims a slot with one compare-and-swap on the shared position
+// and then fills or reads it in place, with no locks and no copying of the board on the producer's side
+// nothing blocks: the try_ functions return NULL when the ring is full/empty and the caller decides how to wait
+class boardring {
+public:
+	boardring();
+	// size the ring, must be a power of 2; the slots' boards are allocated once and reused all the way through
+	void init(int capacity);
+	// producer: claim the next empty slot to fill in, or NULL if the ring is full; hand it over with end_push
+	struct ringslot * try_push();
+	void end_push(struct ringslot * s);
+	// consumer: claim the next ready board, or NULL if there isn't one yet; give the slot back with end_pop once done reading
+	struct ringslot * try_pop();
+	void end_pop(struct ringslot * s);
+	// how many producers are still running: once this is 0 and try_pop comes back empty, there are no more boards coming
+	std::atomic<int> producing;
+private:
+	std::vector<struct ringslot> slots;
+	size_t mask;
+	// each one on its own cache line, producers and consumers hammer on different ones
+	char pad0[64];
+	std::atomic<size_t> push_pos;
+	char pad1[64];
+	std::atomic<size_t> pop_pos;
+	char pad2[64];
+};
+
+
+// producer thread: take game indices from 'next_game' until 'end_game', generate each board and put it in the ring
+// waits (yielding the core) while the ring is full; decrements ring->producing when done
+void produce_boards(unsigned long long runseed, std::atomic<int> * next_game, int end_game, class boardring * ring);
+
+
+
+
+
+#endif
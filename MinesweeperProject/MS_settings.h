@@ -29,13 +29,13 @@ X/Y/mines
 #define	FIND_EARLY_ZEROS_def		false
 // there are 3 guessing modes: 0=random, 1=smartguess, 2=perfectmode
 #define GUESSING_MODE_def			2
-#define VERSION_STRING_def			"v5.2"
+#define VERSION_STRING_def			"v5.3"
 // controls what gets printed to the console
 // 0: prints almost nothing to screen, 1: prints game-end to screen, 2: prints everything to screen
 // -1: logfile is empty except for run-end results
 // 3: lots of extra smartguess debug info, everything to screen & log
 #define SCREEN_def					1
-// if SPECIFY_SEED = 0, will generate a new seed from current time
+// if SPECIFY_SEED = 0, play the whole run; otherwise replay only that game # of the run (needs the run seed)
 #define SPECIFY_SEED_def			0
 
 
@@ -44,6 +44,50 @@ X/Y/mines
 #define HISTOGRAM_RESOLUTION		15
 #define HISTOGRAM_MAX_HORIZ_SIZE	40
 
+// win validation is done with running counters kept by reveal/set_flag, so it is O(1)
+// set this to true to ALSO walk the whole field when the last flag is placed and check the counters against it (debug only, slow)
+#define WIN_VALIDATION_FULL_AUDIT	false
+
+// infinite mode (-infinite): the field is generated one chunk at a time as the solver reaches it
+// how many chunks' mine planes to keep around; past this the least-recently-used ones are dropped and regenerated from the seed if needed
+#define INFINITE_MINE_CACHE			1024
+// how far (in chunks) around the latest move the board is remembered; once twice that square is stored, everything
+// outside it is forgotten, which is what keeps memory flat no matter how big the budget is
+#define INFINITE_KEEP_RADIUS		6
+
+// tiled logic (-tthreads): a round of single-cell/two-cell/multicell work is cut into tiles of this many cells (or pods)
+// and the tiles are handed to the thread pool; rounds smaller than one tile just run serially like before
+#define LOGIC_TILE_SIZE				512
+
+// worker processes (-workers): how often the supervisor checks on them, in ms, and how many seconds a worker can go
+// without publishing a finished game before it's considered hung and gets killed (the game it was on is counted as an
+// unexpected loss). unless -timeout says otherwise, that's WORKER_HANG_TIMEOUT plus 1 second per WORKER_HANG_CELLS_PER_SEC
+// cells of the field, so a big field's slow-but-healthy games don't get killed
+#define WORKER_POLL_MS				100
+#define WORKER_HANG_TIMEOUT			600
+#define WORKER_HANG_CELLS_PER_SEC	1000
+// how many times the supervisor tries to get a consistent copy of a live worker's stats before keeping the copy it has
+#define WORKER_READ_TRIES			1000
+// how often the supervisor prints its progress to the screen, in seconds
+#define WORKER_REPORT_SEC			10
+
+// with -checkpoint, how often (in seconds) the run stats and the next game index are saved so the run can be -resume'd
+#define CHECKPOINT_INTERVAL_SEC		60
+
+// with -targetci, the winrate interval is checked every time this many more games are done (always at the same game
+// counts, so the run stops at the same place no matter how many threads play it); and the z for a 95% interval
+#define TARGET_CI_CHECK_GAMES		1000
+#define TARGET_CI_Z					1.959964
+
+// with -pipeline, how many ready boards can be waiting between the generator threads and the game threads (a power of 2)
+#define PIPELINE_RING_SIZE			256
+
+// run totals that are sums of floats (luck, smartguess deviation) are kept as fixed-point integers with this many steps per 1.0,
+// so they add up exactly and the final report doesn't depend on what order the games finished in (or how many threads played them)
+// 2^24: fine enough that the rounding never shows in the report, and leaves 39 bits of a long long for the whole part
+// (stats files store the raw value, so changing this needs a new STATSFILE_VERSION)
+#define STATS_FIXED_ONE				16777216.
+
 // after X loops, see if single-cell logic can take over... if not, will resume two-cell
 // surprisingly two-cell logic seems to consume even more time than the recursive smartguess when this value is high
 #define TWOCELL_LOOP_CUTOFF			3
@@ -8,13 +8,10 @@
 #include "MS_settings.h"
 #include "MS_basegame.h"
 #include "MS_stats.h"
+#include "MS_threadpool.h"
 
 #include "MS_solver.h" // include myself
 
-// a global flag used in the recursive smartguess
-bool recursion_safety_valve = false; // if recursion goes down a rabbithole, start taking shortcuts (not needed outside this file)
-
-
 // **************************************************************************************
 // member functions for the buttload of structs
 
@@ -89,11 +86,11 @@ inline struct podwise_return& podwise_return::operator+=(const int& rhs) {
 }
 // return the WEIGHTED average of all the contents that are <= mines_remaining
 // also modifies the object by deleting any solutions with answers > mines_remaining
-float podwise_return::avg() {
+float podwise_return::avg(int mines_remaining) {
 	float a = 0; int total_weight = 0;
 	std::list<struct solutionobj>::iterator listit = solutions.begin();
 	while (listit != solutions.end()) {
-		if (listit->answer <= float(mygame.get_mines_remaining())) {
+		if (listit->answer <= float(mines_remaining)) {
 			if (USE_WEIGHTED_AVG) {
 				a += listit->answer * listit->allocs_encompassed;
 				total_weight += listit->allocs_encompassed;
@@ -174,11 +171,13 @@ int pod::scan() {
 	return 0;
 }
 // init from root, mines from root, link_cells empty, cell_list from root
-pod::pod(class cell * new_root) {
+pod::pod(class cell * new_root, class game * g) {
 	root = new_root;
-	mines = new_root->get_effective(); // the root is visible, so this is fine
+	mines = g->view.effective_of(new_root); // the root is visible, so the view has it
 	links = std::list<struct link>(); // links initialized empty
-	cell_list = mygame.filter_adjacent(new_root, UNKNOWN); // find adjacent unknowns
+	struct adjlist unk;
+	g->filter_adjacent(new_root, UNKNOWN, &unk); // find adjacent unknowns
+	cell_list.assign(unk.begin(), unk.end());
 	chain_idx = -1; // set later
 	cell_list_size = -1; // set later
 }
@@ -245,7 +244,7 @@ std::list<struct scenario> pod::find_scenarios(bool use_t2_opt) {
 	// determine the range of values K to use, how many cells to pick out of the links (because there will be variable mines in the non-link cells)
 	int t = (mines - (size() - links.size()));
 	int start = max(0, t); // shouldn't be negative
-	int end = min(mines, links.size()); // lesser of mines/links
+	int end = min(mines, (int)links.size()); // lesser of mines/links
 
 	for (int i = start; i <= end; i++) {
 		// FIRST-TIER optimization: ignore actual allocation in non-link cells, just find all ways to put flags on link cells
@@ -327,6 +326,10 @@ chain::chain() {
 std::list<struct pod>::iterator chain::root_to_pod(class cell * linked_root) {
 	if (linked_root == NULL)
 		return podlist.end();
+	if (!root_index.empty()) { // the master chain can look it up directly
+		std::unordered_map<class cell *, std::list<struct pod>::iterator>::iterator f = root_index.find(linked_root);
+		return (f == root_index.end()) ? podlist.end() : f->second;
+	}
 	std::list<struct pod>::iterator pod_iter;
 	for (pod_iter = podlist.begin(); pod_iter != podlist.end(); pod_iter++) {
 		if (pod_iter->root == linked_root)
@@ -336,9 +339,22 @@ std::list<struct pod>::iterator chain::root_to_pod(class cell * linked_root) {
 	// is this line possible? is it not? I CAN'T REMEMBER
 	return podlist.end(); // note this actually points to the next open position; there's no real element here!
 }
+// build the root->pod lookup from the current podlist; afterwards, only remove pods with erase_pod or it goes stale
+void chain::index_roots() {
+	root_index.clear();
+	root_index.reserve(podlist.size());
+	for (std::list<struct pod>::iterator pod_iter = podlist.begin(); pod_iter != podlist.end(); pod_iter++) {
+		root_index[pod_iter->root] = pod_iter;
+	}
+}
+// erase a pod and keep the root->pod lookup in sync, returns the iterator after it just like list::erase
+std::list<struct pod>::iterator chain::erase_pod(std::list<struct pod>::iterator killme) {
+	if (!root_index.empty()) { root_index.erase(killme->root); }
+	return podlist.erase(killme);
+}
 // returns iterator to the fth pod
 std::list<struct pod>::iterator chain::int_to_pod(int f) {
-	if (f > podlist.size()) { return podlist.end(); }
+	if (f > (int)podlist.size()) { return podlist.end(); }
 	std::list<struct pod>::iterator iter = podlist.begin();
 	for (int i = 0; i < f; i++) { iter++; }
 	return iter;
@@ -346,11 +362,11 @@ std::list<struct pod>::iterator chain::int_to_pod(int f) {
 
 // returns a VECTOR of POD-LIST ITERATORS to the pods in the podlist that are within 5x5 of the given pod
 // if include_corners=false, also ignore the corners of the 5x5
-std::vector<std::list<struct pod>::iterator> chain::get_5x5_around(std::list<struct pod>::iterator center, bool include_corners) {
+std::vector<std::list<struct pod>::iterator> chain::get_5x5_around(std::list<struct pod>::iterator center, bool include_corners, class game * g) {
 	std::vector<std::list<struct pod>::iterator> retme;
 	for (int b = -2; b < 3; b++) { for (int a = -2; a < 3; a++) { // iterate over 5x5
 		if ((!include_corners && ((a == -2 || a == 2) && (b == -2 || b == 2))) || (a == 0 && b == 0)) { continue; } // skip myself and also the corners
-		class cell * other = mygame.cellptr(center->root->x + a, center->root->y + b);
+		class cell * other = g->cellptr(g->xof(center->root) + a, g->yof(center->root) + b);
 		if ((other == NULL) || (other->get_status() != VISIBLE)) { continue; } // if the cell doesn't exist or isn't VISIBLE, then skip
 		std::list<struct pod>::iterator otherpod = this->root_to_pod(other);// find the pod in the chain with this cell as root!
 		if (otherpod != this->podlist.end()) { // if 'other' has a corresponding pod, then add to the list
@@ -376,10 +392,10 @@ std::vector<struct chain> chain::sort_into_chains(int r, bool reduce) {
 	}
 	return chain_list;
 }
-// RECURSE and mark connected chains/islands... should only be called outside of recursion, when it is a "master chain"
+// find and mark connected chains/islands... should only be called outside of recursion, when it is a "master chain"
 // assumes that links have already been set up, duplicates removed, and subtraction performed, etc
 // returns the number of disjoint chains found (returns 4 if chains have id 0/1/2/3) (returns 1 if already one contiguous chain, id 0)
-int chain::identify_chains() {
+int chain::identify_chains(std::vector<struct pod *> * todo) {
 	// first, reset any chain indices (to allow for calling it again inside recursion)
 	for (std::list<struct pod>::iterator pod_iter = podlist.begin(); pod_iter != podlist.end(); pod_iter++) {
 		pod_iter->chain_idx = -1;
@@ -388,26 +404,31 @@ int chain::identify_chains() {
 	int next_chain_idx = 0;
 	for (std::list<struct pod>::iterator pod_iter = podlist.begin(); pod_iter != podlist.end(); pod_iter++) {
 		if (pod_iter->chain_idx == -1) {
-			identify_chains_recurse(next_chain_idx, &(*pod_iter));
+			identify_chains_fill(next_chain_idx, &(*pod_iter), todo);
 			next_chain_idx++;
 		}
 	}
 	return next_chain_idx;
 }
-void chain::identify_chains_recurse(int idx, struct pod * me) {
-	if (me->chain_idx != -1) {
-		assert(me->chain_idx == idx); // if its not -1 then it damn well better be idx
-		return; // this pod already marked by something (hopefully this same recursion call)
-	}
-	me->chain_idx = idx; // paint it
-	for (std::list<struct link>::iterator linkit = me->links.begin(); linkit != me->links.end(); linkit++) {
-		// for each link object 'linkit' in me...
-		for (std::list<class cell *>::iterator rootit = linkit->linked_roots.begin(); rootit != linkit->linked_roots.end(); rootit++) {
-			// for each root pointer 'rootit' in linkit...
-			// ...get the pod that is linked...
-			struct pod * linked_pod = &(*(root_to_pod(*rootit)));
-			// ...and recurse on that pod with the same index
-			identify_chains_recurse(idx, linked_pod);
+// paint everything reachable from 'me' with idx, using an explicit stack instead of recursion so a huge chain can't overflow
+// 'todo' is just scratch space for the stack, passed in so it can be reused
+void chain::identify_chains_fill(int idx, struct pod * me, std::vector<struct pod *> * todo) {
+	todo->clear();
+	todo->push_back(me);
+	while (!todo->empty()) {
+		struct pod * p = todo->back();
+		todo->pop_back();
+		if (p->chain_idx != -1) {
+			assert(p->chain_idx == idx); // if its not -1 then it damn well better be idx
+			continue; // this pod already marked by something (hopefully this same call)
+		}
+		p->chain_idx = idx; // paint it
+		for (std::list<struct link>::iterator linkit = p->links.begin(); linkit != p->links.end(); linkit++) {
+			// for each link object 'linkit' in p...
+			for (std::list<class cell *>::iterator rootit = linkit->linked_roots.begin(); rootit != linkit->linked_roots.end(); rootit++) {
+				// for each root pointer 'rootit' in linkit, get the pod that is linked and queue it with the same index
+				todo->push_back(&(*(root_to_pod(*rootit))));
+			}
 		}
 	}
 	return;
@@ -415,62 +436,58 @@ void chain::identify_chains_recurse(int idx, struct pod * me) {
 
 
 // constructor
-riskholder::riskholder(int x, int y) {
-	std::vector<float> asdf2;	// needed for using the 'resize' command
-	asdf2.reserve(4);			// the max size needed is 8 but that's unlikely, lets just start with 4
-	std::vector<std::vector<float>> asdf;	// init empty
-	asdf.resize(y, asdf2);					// fill it with copies of asdf2
-	asdf.shrink_to_fit();					// set capacity exactly where i want it, no bigger
-	riskarray.clear();			// init empty
-	riskarray.resize(x, asdf);	// fill it with copies of asdf
-	riskarray.shrink_to_fit();	// set capacity exactly where i want it, no bigger
-}
-// takes a cell pointer and adds a risk to its list... could modify to use x/y, but why bother?
+riskholder::riskholder(class game * newgame) {
+	g = newgame;
+	slot.assign(g->field.size(), -1);
+	entries.reserve(256);
+}
+// takes a cell pointer and adds a risk to its entry, making one if it's the first risk for this cell
 void riskholder::addrisk(class cell * foo, float newrisk) {
-	(riskarray[foo->x][foo->y]).push_back(newrisk);
+	int idx = (int)(foo - &g->field[0]);
+	if (slot[idx] == -1) {
+		slot[idx] = entries.size();
+		struct riskentry e; e.me = foo; e.sum = 0.; e.worst = -1.; e.count = 0;
+		entries.push_back(e);
+	}
+	struct riskentry * e = &entries[slot[idx]];
+	e->sum += newrisk; // same order as the old per-cell lists, so the average comes out bit-identical
+	if (newrisk > e->worst) { e->worst = newrisk; }
+	e->count++;
+}
+// order the touched cells the way the old full-field scan visited them (x outer, y inner) so ties come out in the same order
+bool riskholder::sort_entries(const struct riskentry & a, const struct riskentry & b) {
+	int ax = g->xof(a.me), bx = g->xof(b.me);
+	if (ax != bx) { return ax < bx; }
+	return g->yof(a.me) < g->yof(b.me);
 }
-// iterate over itself and return the stuff tied for lowest risk
+// iterate over the touched cells and return the stuff tied for lowest risk, also resets for next time
 std::pair<float, std::list<class cell *>> riskholder::findminrisk() {
 	std::list<class cell *> minlist;
 	float minrisk = 100.;
-	for (int m = 0; m < myruninfo.get_SIZEX(); m++) {
-		for (int n = 0; n < myruninfo.get_SIZEY(); n++) {
-			float j = finalrisk(m, n);
-			if ((j == -1.) || (j > minrisk))
-				continue;
-			if (j < minrisk) {
-				minrisk = j;
-				minlist.clear();
-			}
-			minlist.push_back(&mygame.field[m][n]);
+	std::sort(entries.begin(), entries.end(), [this](const struct riskentry & a, const struct riskentry & b) { return sort_entries(a, b); });
+	for (int i = 0; i < (int)entries.size(); i++) {
+		float j = finalrisk(&entries[i]);
+		slot[entries[i].me - &g->field[0]] = -1; // clear it for use next time
+		if (j > minrisk)
+			continue;
+		if (j < minrisk) {
+			minrisk = j;
+			minlist.clear();
 		}
+		minlist.push_back(entries[i].me);
 	}
+	entries.clear();
 	std::pair<float, std::list<class cell *>> retme(minrisk, minlist);
 	return retme;
 }
-// find the avg/max/min of the risks and return that value; also clear the list. if list is already empty, return -1
-float riskholder::finalrisk(int x, int y) {
-	if ((riskarray[x][y]).empty())
-		return -1.;
-	float retval = 0.;
-	int s = (riskarray[x][y]).size();
-	if (s == 1) { 
-		retval = riskarray[x][y][0]; 
-	} else if (RISK_CALC_METHOD == 0) { // AVERAGE
-		float sum = 0.;
-		for (int i = 0; i < s; i++) {
-			sum += riskarray[x][y][i];
-		}
-		retval = sum / float(s);
-	} else if (RISK_CALC_METHOD == 1) { // MAXIMUM
-		retval = -1.;
-		for (int i = 0; i < s; i++) {
-			float t = riskarray[x][y][i];
-			if (t > retval) { retval = t; }
-		}
+// find the avg/max of the risks of one cell and return that value
+float riskholder::finalrisk(struct riskentry * e) {
+	if (e->count == 1) { return e->sum; }
+	if (RISK_CALC_METHOD == 0) { // AVERAGE
+		return e->sum / float(e->count);
+	} else { // MAXIMUM
+		return e->worst;
 	}
-	(riskarray[x][y]).clear(); // clear it for use next time
-	return retval;
 }
 
 
@@ -480,6 +497,34 @@ scenario::scenario(std::list<std::list<struct link>::iterator> map, int num) {
 }
 
 
+// constructor: the board must already be init'd (the riskholder is sized to it)
+solvercontext::solvercontext(class game * newgame, class runinfo * newinfo, int newmode, bool newfindz, class threadpool * newpool) : risk(newgame) {
+	g = newgame; info = newinfo; guessing_mode = newmode; find_early_zeros = newfindz; pool = newpool;
+	recursion_safety_valve = false;
+	dummypod.root = &dummycell; // can't use constructor cuz constructor automatically fills the cell_list
+	dummylist.resize(1, dummypod);
+	dummyitr = dummylist.begin(); // must have an iterator to the dummy, but it doesn't need to be in the same list as the others
+	touched_pass = 0;
+}
+// new settings, and resize for the board if it was re-init'd at a different size; all the scratch space is kept
+// (the chain builder's per-cell scratch and the interior set already resize themselves when the board does)
+void solvercontext::reset(int newmode, bool newfindz, class threadpool * newpool) {
+	guessing_mode = newmode; find_early_zeros = newfindz; pool = newpool;
+	recursion_safety_valve = false;
+	if (risk.slot.size() != g->field.size()) { risk.slot.assign(g->field.size(), -1); }
+	risk.entries.clear();
+}
+// is there more than 1 thread to split the tiled logic across?
+bool solvercontext::parallel() {
+	return (pool != NULL) && (pool->size() > 1);
+}
+// cut [0, nitems) into LOGIC_TILE_SIZE tiles and call job(lo, hi) on each, spread across the pool (or all at once, if serial)
+void solvercontext::run_tiled(int nitems, const std::function<void(int, int)> & job) {
+	if (!parallel()) { job(0, nitems); return; }
+	pool->run_tiled(nitems, LOGIC_TILE_SIZE, job);
+}
+
+
 
 
 
@@ -630,35 +675,66 @@ smartguess {
 
 
 
+// read-only half of step 2 of the chain builder: would the step-2 loop body change anything if it ran on this pod right now?
+// goes through exactly the same checks in the same order, but stops at the first one that would act instead of acting
+// must be kept in sync with step 2 below!
+bool multicell_pod_can_act(struct chain * buildme, std::list<struct pod>::iterator podit, std::list<struct pod>::iterator dummyitr, class game * g) {
+	std::vector<std::list<struct pod>::iterator> around = buildme->get_5x5_around(podit, false, g);
+	for (int b = 0; b < (int)around.size(); b++) {
+		std::list<struct pod>::iterator otherpod = around[b];
+		std::vector<std::vector<class cell *>> N = extract_overlap(podit->cell_list, otherpod->cell_list);
+		if (N[0].empty()) { return true; } // duplicate or subset
+		for (int s = b; s < (int)around.size(); s++) {
+			std::list<struct pod>::iterator secondpod;
+			if (s == b) {
+				secondpod = dummyitr;
+			} else {
+				secondpod = around[s];
+				if (podit->cell_list.size() < 4 || podit->mines < 2) { break; }
+			}
+			int Z = (podit->mines - otherpod->mines) - secondpod->mines;
+			bool safemode = ((Z == 0) && (s != b));
+			if (!(Z > 0 || safemode)) { continue; }
+			if (!((int)N[2].size() > otherpod->mines)) { continue; }
+			std::vector<std::vector<class cell *>> U = extract_overlap(podit->cell_list, secondpod->cell_list);
+			if (!((int)U[2].size() > otherpod->mines)) { continue; }
+			if (!(int(podit->cell_list.size() - N[2].size() - U[2].size()) == Z)) { continue; }
+			std::vector<std::vector<class cell *>> V = extract_overlap(N[2], U[2]);
+			if (!(V[2].size() == 0)) { continue; }
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
 // build the master chain that will be used for smartguess... encapsulates steps 1/2/3 of original 11-stage plan
 // also apply "multicell" versions of nonoverlap-safe and nonoverlap-flag; partial matches and chaining logic rules together
 // may identify some cells as "definite safe" or "definite mine", and will reveal/flag them internally
 // if no cells are flagged/cleared, will output the master chain thru input arg for passing to full recursive function below
 // return: 1=win/-1=loss/0=continue (winning is rare but theoretically possible, but cannot lose unless something is seriously out of whack)
-int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * thingsdone) {
-	static class cell dummycell; // cell w/ value 0
-	static struct pod dummypod; // pod w/ cell_list empty
-	static std::list<struct pod> dummylist; // one-entry list for dummypod
-	static std::list<struct pod>::iterator dummyitr; // iterator to beginning of dummylist
-	if (dummylist.empty()) { // one-time init for these static things
-		dummypod.root = &dummycell; // can't use constructor cuz constructor automatically fills the cell_list
-		dummylist.resize(1, dummypod);
-		dummyitr = dummylist.begin(); // must have an iterator to the dummy, but it doesn't need to be in the same list as the others
-	}
+int strat_multicell_logic_and_chain_builder(struct solvercontext * ctx, struct chain * buildme, int * thingsdone) {
+	class game * g = ctx->g;
+	std::list<struct pod>::iterator dummyitr = ctx->dummyitr; // pod w/ value 0 and cell_list empty
 
 	std::list<class cell *> clearme;
 	std::list<class cell *> flagme;
 
-	// step 1: iterate over field, get 'visible' cells, use them as roots to build pods and build the chain.
+	// step 1: get the frontier (visible cells touching unknowns) from the live set the game keeps, use them as roots to build pods and build the chain.
 	// chain is non-optimized: includes duplicates, before pod-subtraction.
 	// pods are added to the chain already sorted (reading order by root), as are their cell_list contents.
-	for (int y = 0; y < myruninfo.get_SIZEY(); y++) {
-		for (int x = 0; x < myruninfo.get_SIZEX(); x++) { // iterate over each cell
-			if (mygame.field[x][y].get_status() == VISIBLE) {
-				buildme->podlist.push_back(pod(&mygame.field[x][y])); // constructor gets adj unks for the given root
-			}
-		}
+	std::vector<class cell *> & frontier = ctx->frontier;
+	std::vector<struct pod> & built = ctx->built;
+	g->get_frontier(&frontier);
+	built.resize(frontier.size());
+	ctx->run_tiled((int)frontier.size(), [&](int lo, int hi) { // each pod only reads the board, so tiles can run side by side
+		for (int i = lo; i < hi; i++) { built[i] = pod(frontier[i], g); } // constructor gets adj unks for the given root
+	});
+	for (int i = 0; i < (int)built.size(); i++) {
+		buildme->podlist.push_back(std::move(built[i]));
 	}
+	buildme->index_roots(); // so get_5x5_around doesn't walk the whole podlist for each neighbor
 
 	// step 2: iterate over pods, check for dupes and subsets (call extract_overlap on each pod with root in 5x5 around my root)
 	// this is where the "multicell logic" comes into play, NOV-SAFE and NOV-FLAG partial matches chained together many times
@@ -675,13 +751,41 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 				*** begin NOV-FLAGx3 and NOV-SAFEx3 logic ***
 	*/
 
+	// on a big field each pass is split in two: first every pod works out (in parallel, read-only) whether it would change anything,
+	// then the usual serial pass only runs the pods that said yes plus any pod near one that has actually changed since.
+	// a pod only reads and writes pods with roots in its 5x5, so a pod more than 4 away from every change gives the same answer
+	// it gave at the start of the pass. the serial order is untouched, so the result is exactly what the plain serial pass gives
+	std::vector<std::list<struct pod>::iterator> & podvec = ctx->podvec;
+	std::vector<char> & can_act = ctx->can_act; // indexed same as game::field, by pod root
+	std::vector<int> & touched = ctx->touched; // indexed same as game::field, == touched_pass if something within 4 changed this pass
+	int & touched_pass = ctx->touched_pass;
+	if (touched.size() != g->field.size()) { touched.assign(g->field.size(), 0); can_act.assign(g->field.size(), 0); }
+
 	bool changes = false;
 	bool erased_myself = false;
 	do {
 		changes = false;
+		bool tiled = ctx->parallel() && (buildme->podlist.size() > LOGIC_TILE_SIZE);
+		if (tiled) {
+			touched_pass++;
+			podvec.clear();
+			for (std::list<struct pod>::iterator podit = buildme->podlist.begin(); podit != buildme->podlist.end(); podit++) { podvec.push_back(podit); }
+			ctx->run_tiled((int)podvec.size(), [&](int lo, int hi) {
+				for (int i = lo; i < hi; i++) {
+					std::list<struct pod>::iterator p = podvec[i];
+					can_act[p->root - &g->field[0]] = multicell_pod_can_act(buildme, p, dummyitr, g);
+				}
+			});
+		}
 		for (std::list<struct pod>::iterator podit = buildme->podlist.begin(); podit != buildme->podlist.end(); ) { // intentionally missing post-loop incremnt
-			std::vector<std::list<struct pod>::iterator> around = buildme->get_5x5_around(podit, false);
-			for (int b = 0; b < around.size(); b++) {
+			class cell * myroot = podit->root;
+			if (tiled && !can_act[myroot - &g->field[0]] && (touched[myroot - &g->field[0]] != touched_pass)) {
+				podit++; continue; // nothing to do here at the start of the pass, and nothing nearby has changed since
+			}
+			bool changes_before = changes;
+			changes = false;
+			std::vector<std::list<struct pod>::iterator> around = buildme->get_5x5_around(podit, false, g);
+			for (int b = 0; b < (int)around.size(); b++) {
 				std::list<struct pod>::iterator otherpod = around[b]; // for each pod 'otherpod' with root within 5x5 found...
 
 				std::vector<std::vector<class cell *>> N = extract_overlap(podit->cell_list, otherpod->cell_list);
@@ -689,7 +793,7 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 				if (N[0].empty() && N[1].empty()) { // means podit == otherpod
 					// if total duplicate, delete OTHER (not me)
 					changes = true;
-					buildme->podlist.erase(otherpod); // don't even need to rebuild 'around' vector!
+					buildme->erase_pod(otherpod); // don't even need to rebuild 'around' vector!
 				} else if (N[0].empty()) {			// means podit < otherpod
 					// if podit has no uniques but otherpod does, then podit is subset of otherpod...
 					changes = true;
@@ -708,7 +812,7 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 					// begin the NOV-FLAGx2, NOV-FLAGx3, and NOV-SAFEx3 section!
 					// there are 5 stages of checks to know if FLAGx3 or SAFEx3 can be applied... A=podit, B1=otherpod, B2=secondpod
 					// decided to use "if not true, continue" syntax cuz I didn't want to indent 5 layers of nested if-statements
-					for (int s = b; s < around.size(); s++) { // start from b cuz only need all combos, not both orders of each combo
+					for (int s = b; s < (int)around.size(); s++) { // start from b cuz only need all combos, not both orders of each combo
 						std::list<struct pod>::iterator secondpod;
 						if (s == b) {
 							secondpod = dummyitr; // NOV-FLAGx3 special case to check NOV-FLAGx2, use pod with value=0 and size=0
@@ -724,14 +828,14 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 						if ((Z == 0) && (s != b)) { safemode = true; } // do not try NOV-SAFEx3 during 0,0 special case
 						if (!(Z > 0 || safemode)) { continue; } // if neither is true, skip
 						// 2) |overlap(A,B1)| > B1
-						if (!(N[2].size() > otherpod->mines)) { continue; }
+						if (!((int)N[2].size() > otherpod->mines)) { continue; }
 						// 3) |overlap(A,B2)| > B2
 						// delay second call to extract_overlap as long as possible, so it might be skipped
 						// vector N holds comparison between A and B1, vector U holds comparison between A and B2
 						std::vector<std::vector<class cell *>> U = extract_overlap(podit->cell_list, secondpod->cell_list);
-						if (!(U[2].size() > otherpod->mines)) { continue; }
+						if (!((int)U[2].size() > otherpod->mines)) { continue; }
 						// 4) size(A) - |overlap(A,B1)| - |overlap(A,B2)| == Z, works whether Z is 0 or positive
-						if (!(((podit->cell_list.size() - N[2].size()) - U[2].size()) == Z)) { continue; }
+						if (!((((int)podit->cell_list.size() - (int)N[2].size()) - (int)U[2].size()) == Z)) { continue; }
 						// 5) |overlap( overlap(A,B1) , overlap(A,B2) )| == 0, AKA both overlapping sections must not overlap eachother
 						// delay third call to extract_overlap as long as possible, too, so it might be skipped
 						std::vector<std::vector<class cell *>> V = extract_overlap(N[2], U[2]);
@@ -751,7 +855,7 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 							clearme.insert(clearme.end(), U[1].begin(), U[1].end());
 							secondpod->cell_list = U[2];
 							// then erase podit! note: erasing podit (ME) isn't so simple, cuz then it won't be able to inc the iterator...
-							podit = buildme->podlist.erase(podit); erased_myself = true;
+							podit = buildme->erase_pod(podit); erased_myself = true;
 							goto LABEL_CONTINUE_PODIT_LOOP;
 						} else {
 							// NOV-FLAGx3: if flagmode=true, then O+S cover all of podit except for Z cells. these cells are guaranteed flags.
@@ -764,7 +868,7 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 							// then reduce podit to only these Z cells and flag them! no erase
 							std::vector<std::vector<class cell *>> temp = extract_overlap(podit->cell_list, N[2]); // subtract O from podit
 							std::vector<std::vector<class cell *>> uniq = extract_overlap(temp[0], U[2]); // subtract S from podit
-							assert(uniq[0].size() == Z);
+							assert((int)uniq[0].size() == Z);
 							podit->cell_list = uniq[0];
 							podit->mines = Z;
 							flagme.insert(flagme.end(), uniq[0].begin(), uniq[0].end());
@@ -777,6 +881,13 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 			// i need to jump to the next iteration of podit loop, tho
 			// therefore whenever I erase podit, don't increment podit on that iteration of the loop
 		LABEL_CONTINUE_PODIT_LOOP:
+			if (tiled && changes) { // anything within 4 of me might give a different answer now
+				for (int b = -4; b < 5; b++) { for (int a = -4; a < 5; a++) {
+					class cell * near = g->cellptr(g->xof(myroot) + a, g->yof(myroot) + b);
+					if (near != NULL) { touched[near - &g->field[0]] = touched_pass; }
+				}}
+			}
+			changes = changes || changes_before;
 			if (erased_myself) { erased_myself = false; } else { podit++; } // implement my own ++ instead of in the for-loop
 		} // end for each pod
 	} while (changes);
@@ -785,16 +896,16 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 
 	// step 3: clear the clearme and flag the flagme
 	if (clearme.size() || flagme.size()) {
-		if (myruninfo.SCREEN == 3) myprintfn(2, "DEBUG: in multicell, found %i clear and %i flag\n", clearme.size(), flagme.size());
+		if (ctx->info->SCREEN == 3) myprintfn(2, "DEBUG: in multicell, found %i clear and %i flag\n", clearme.size(), flagme.size());
 		for (std::list<class cell *>::iterator cit = clearme.begin(); cit != clearme.end(); cit++) { // clear-list
-			int r = mygame.reveal(*cit);
+			int r = g->reveal(*cit);
 			*thingsdone += bool(r);
 			if (r == -1) {
 				myprintfn(2, "ERR: Unexpected loss during multicell logic reveal, must investigate!!\n"); assert(0); return -2;
 			}
 		}
 		for (std::list<class cell *>::iterator fit = flagme.begin(); fit != flagme.end(); fit++) { // flag-list
-			int r = mygame.set_flag(*fit);
+			int r = g->set_flag(*fit);
 			*thingsdone += bool(r);
 			if (r == -1) { return 1; } // game won!
 		}
@@ -809,7 +920,8 @@ int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * things
 //				^ plus, searches for chain solutions that are definitely invalid and eliminates them
 // return: 1=win/-1=loss/0=continue (cannot lose unless something is seriously out of whack)
 // but, it only causes smartguess to return to the main play_game level if this function adds to *thingsdone
-int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return> * prvect, std::list<class cell *> * interior_list, int * thingsdone) {
+int strat_endsolver_and_solution_reducer_logic(struct solvercontext * ctx, std::vector<struct podwise_return> * prvect, class cellset * interior_list, int * thingsdone) {
+	class game * g = ctx->g;
 	/* ENDSOLVER uses the following logic:
 	1: for chain X in retholder, if max(X)+min(others) > mines_remain, then:
 		   anything in X with value max(X) is definitely an invalid solution. also, should check the next-biggest in X, and so on.
@@ -829,7 +941,7 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 	for (std::vector<struct podwise_return>::iterator priter = prvect->begin(); priter != prvect->end(); priter++) {
 		num_sol_start += priter->solutions.size();
 	}
-	int minesval = mygame.get_mines_remaining();
+	int minesval = g->get_mines_remaining();
 
 	bool checkminimums = true, checkmaximums = true; // flags
 	do {
@@ -900,7 +1012,7 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 			// if this PR has only one solution remaining, and it is unique, that solution can be applied! unlikely but possible
 			if (((priter->solutions.size()) == 1) && (priter->solutions.front().allocs_encompassed == 1)) {
 				for (std::list<class cell *>::iterator celliter = priter->solutions.front().allocation.begin(); celliter != priter->solutions.front().allocation.end(); celliter++) {
-					int r = mygame.set_flag(*celliter);
+					int r = g->set_flag(*celliter);
 					*thingsdone += bool(r);
 					if (r == -1) { return 1; } else if (r == 2) { assert(0); return -2; }
 				}
@@ -916,9 +1028,9 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 	}
 	if (minsum == minesval) {
 		// int_list is safe
-		for (std::list<class cell *>::iterator iiter = interior_list->begin(); iiter != interior_list->end(); iiter++) {
+		for (std::vector<class cell *>::iterator iiter = interior_list->begin(); iiter != interior_list->end(); iiter++) {
 			*thingsdone += 1;
-			if (mygame.reveal(*iiter) == -1) {
+			if (g->reveal(*iiter) == -1) {
 				myprintfn(2, "ERR: Unexpected loss during smartguess endsolver!!\n"); assert(0); return -2;
 			}
 		}
@@ -937,7 +1049,7 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 			// if this PR has only one solution remaining, and it is unique, that solution can be applied! unlikely but possible
 			if (((priter->solutions.size()) == 1) && (priter->solutions.front().allocs_encompassed == 1)) {
 				for (std::list<class cell *>::iterator celliter = priter->solutions.front().allocation.begin(); celliter != priter->solutions.front().allocation.end(); celliter++) {
-					int r = mygame.set_flag(*celliter);
+					int r = g->set_flag(*celliter);
 					*thingsdone += bool(r);
 					if (r == -1) { return 1; } else if (r == 2) { assert(0); return -2; }
 				}
@@ -945,8 +1057,8 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 		}
 	} else if ((maxsum + interior_list->size()) == minesval) {
 		// int_list is all mines
-		for (std::list<class cell *>::iterator iiter = interior_list->begin(); iiter != interior_list->end(); iiter++) {
-			int r = mygame.set_flag(*iiter);
+		for (std::vector<class cell *>::iterator iiter = interior_list->begin(); iiter != interior_list->end(); iiter++) {
+			int r = g->set_flag(*iiter);
 			*thingsdone += bool(r);
 			if (r == -1) { return 1; } else if (r == 2) { assert(0); return -2; }
 		}
@@ -965,7 +1077,7 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 			// if this PR has only one solution remaining, and it is unique, that solution can be applied! unlikely but possible
 			if (((priter->solutions.size()) == 1) && (priter->solutions.front().allocs_encompassed == 1)) {
 				for (std::list<class cell *>::iterator celliter = priter->solutions.front().allocation.begin(); celliter != priter->solutions.front().allocation.end(); celliter++) {
-					int r = mygame.set_flag(*celliter);
+					int r = g->set_flag(*celliter);
 					*thingsdone += bool(r);
 					if (r == -1) { return 1; } else if (r == 2) { assert(0); return -2; }
 				}
@@ -973,7 +1085,7 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 		}
 	}
 
-	if (myruninfo.SCREEN == 3) {
+	if (ctx->info->SCREEN == 3) {
 		// only print the appropriate message if something was actually eliminated
 		if (checkminelim) myprintfn(2, "ENDSOLVER: eliminated a solution for being too SMALL\n");
 		if (checkmaxelim) myprintfn(2, "ENDSOLVER: eliminated a solution for being too LARGE\n");
@@ -996,68 +1108,75 @@ int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return
 // doesn't return cells, instead clears/flags them internally
 // modeflag: 0=guess, 1=multicell, 2=endsolver
 // return: 1=win/-1=loss/0=continue/-2=unexpected loss (winning is unlikely but possible)
-int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
-	static struct riskholder myriskholder(myruninfo.get_SIZEX(), myruninfo.get_SIZEY());
-	std::list<class cell *> interior_list = mygame.unklist;
+int smartguess(struct solvercontext * ctx, struct game_stats * gstats, int * thingsdone, int * modeflag) {
+	class game * g = ctx->g;
 
 	struct chain master_chain = chain();
 	// steps 1/2/3 are done inside this function
-	int r = strat_multicell_logic_and_chain_builder(&master_chain, thingsdone);
+	int r = strat_multicell_logic_and_chain_builder(ctx, &master_chain, thingsdone);
 	if (*thingsdone != 0) {
 		*modeflag = 1;
 		return r;
 	}
 
 
-	// step 4: now that master_chain is refined, remove pod contents (border unk) from interior_unk
-	// will still have some dupes (link cells) but much less than if I did this earlier
-	for (std::list<struct pod>::iterator podit = master_chain.podlist.begin(); podit != master_chain.podlist.end(); podit++) {
-		for (int i = 0; i < podit->size(); i++) {
-			interior_list.remove(podit->cell_list[i]); // remove from interior_list by value (find and remove)
-		}
+	// step 4: interior = all unknowns minus the border unknowns (the pod contents), which the game tracks live
+	// cells only leave the pods by being cleared/flagged in step 3 (which returns early), so the union of the pods IS the border set
+	// refill the context's scratch set rather than copying the unklist, so its field-sized position array is only built once
+	class cellset & interior_list = ctx->interior;
+	interior_list.copy_from(g->unklist);
+	for (std::vector<class cell *>::iterator bit = g->border.begin(); bit != g->border.end(); bit++) {
+		interior_list.remove(*bit); // O(1) swap-remove
 	}
 
 	float interior_risk = 150.;
 	std::vector<struct podwise_return> retholder;	// holds the podwise_return objects I got back from recursion
 	std::vector<struct chain> listofchains;			// holds each separate chain once they're linked and stuff
-	bool use_endsolver = (mygame.get_mines_remaining() <= SMARTGUESS_ENDSOLVER_THRESHOLD);
+	bool use_endsolver = (g->get_mines_remaining() <= SMARTGUESS_ENDSOLVER_THRESHOLD);
 
 	// if there are no interior cells AND it is not near the endgame, then skip the recursion
-	if (!interior_list.empty() || use_endsolver || (GUESSING_MODE_var == 2)) {
+	if (!interior_list.empty() || use_endsolver || (ctx->guessing_mode == 2)) {
 
 		// step 5: iterate again, building links to anything within 5x5(only set MY links)
-		for (std::list<struct pod>::iterator podit = master_chain.podlist.begin(); podit != master_chain.podlist.end(); podit++) {
-			std::vector<std::list<struct pod>::iterator> around = master_chain.get_5x5_around(podit, true); // INCLUDE THE CORNERS
-			for (int i = 0; i < around.size(); i++) {
-				// for each pod 'otherpod' with root within 5x5 found...
-				std::vector<std::vector<class cell *>> n = extract_overlap(podit->cell_list, around[i]->cell_list);
-				// ... only create links within podit!
-				for (int j = 0; j < n[2].size(); j++) {
-					podit->add_link(n[2][j], around[i]->root);
+		// each pod only writes its own links, so the pods can be split into tiles and done side by side
+		std::vector<std::list<struct pod>::iterator> & podvec = ctx->podvec; // the chain builder is done with it
+		podvec.clear();
+		for (std::list<struct pod>::iterator podit = master_chain.podlist.begin(); podit != master_chain.podlist.end(); podit++) { podvec.push_back(podit); }
+		ctx->run_tiled((int)podvec.size(), [&](int lo, int hi) {
+			for (int p = lo; p < hi; p++) {
+				std::list<struct pod>::iterator podit = podvec[p];
+				std::vector<std::list<struct pod>::iterator> around = master_chain.get_5x5_around(podit, true, g); // INCLUDE THE CORNERS
+				for (int i = 0; i < (int)around.size(); i++) {
+					// for each pod 'otherpod' with root within 5x5 found...
+					std::vector<std::vector<class cell *>> n = extract_overlap(podit->cell_list, around[i]->cell_list);
+					// ... only create links within podit!
+					for (int j = 0; j < (int)n[2].size(); j++) {
+						podit->add_link(n[2][j], around[i]->root);
+					}
 				}
 			}
-		}
+		});
 
 		// step 6: identify chains and sort the pods into a VECTOR of chains... 
-		int numchains = master_chain.identify_chains();
+		int numchains = master_chain.identify_chains(&ctx->chain_todo);
 		// smartguess/normal: turn "cell_list" into a simple number, and clear the actual list so it uses less memory while recursing
 		// other modes: retain the cell_list information
-		listofchains = master_chain.sort_into_chains(numchains, !(use_endsolver || (GUESSING_MODE_var == 2)));
+		listofchains = master_chain.sort_into_chains(numchains, !(use_endsolver || (ctx->guessing_mode == 2)));
 
 		// step 7: for each chain, recurse (depth, chain, mode are only arguments) and get back list of answer allocations
 		// handle the multiple podwise_retun objects, just sum their averages
-		if (myruninfo.SCREEN == 3) myprintfn(2, "DEBUG: in smart-guess, # primary chains = %i \n", numchains);
+		if (ctx->info->SCREEN == 3) myprintfn(2, "DEBUG: in smart-guess, # primary chains = %i \n", numchains);
 		float border_allocation = 0;
 		retholder.resize(numchains, podwise_return());
 		for (int s = 0; s < numchains; s++) {
-			recursion_safety_valve = false; // reset the flag for each chain
-			struct podwise_return asdf = podwise_recurse(0, 0, &(listofchains[s]), use_endsolver);
-			border_allocation += asdf.avg();
-			if (use_endsolver || (GUESSING_MODE_var == 2)) { retholder[s] = asdf; } // store the podwise_return obj for later analysis
-			if (recursion_safety_valve) { myprintfn(2, "WARNING: in smart-guess, chain %i aborted recursion early, might return incomplete/misleading data!\n", s); }
-			if ((myruninfo.SCREEN == 3) || recursion_safety_valve) { myprintfn(2, "DEBUG: in smart-guess, chain %i with %i pods found %i answers\n", s, listofchains[s].podlist.size(), asdf.size()); }
-			if (myruninfo.SCREEN == 3) { myprintfn(2, "DEBUG: in smart-guess, chain %i ran with %.3f%% efficiency\n", s, (100. * asdf.efficiency())); }
-			gstats->smartguess_valves_tripped += recursion_safety_valve;
+			ctx->recursion_safety_valve = false; // reset the flag for each chain
+			struct podwise_return asdf = podwise_recurse(ctx, 0, 0, &(listofchains[s]), use_endsolver);
+			border_allocation += asdf.avg(g->get_mines_remaining());
+			if (use_endsolver || (ctx->guessing_mode == 2)) { retholder[s] = asdf; } // store the podwise_return obj for later analysis
+			if (ctx->recursion_safety_valve) { myprintfn(2, "WARNING: in smart-guess, chain %i aborted recursion early, might return incomplete/misleading data!\n", s); }
+			if ((ctx->info->SCREEN == 3) || ctx->recursion_safety_valve) { myprintfn(2, "DEBUG: in smart-guess, chain %i with %i pods found %i answers\n", s, listofchains[s].podlist.size(), asdf.size()); }
+			if (ctx->info->SCREEN == 3) { myprintfn(2, "DEBUG: in smart-guess, chain %i ran with %.3f%% efficiency\n", s, (100. * asdf.efficiency())); }
+			gstats->smartguess_valves_tripped += ctx->recursion_safety_valve;
 		}
 
 
@@ -1066,9 +1185,9 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 		// solution: checks if any solutions fit perfectly, if in perfectmode it also finds & eliminates any invalid solutions
 		// currently runs just if there are not many mines remaining, consider running if there are not many interior-list cells remaining??
 		if (use_endsolver) {
-			int p = strat_endsolver_and_solution_reducer_logic(&retholder, &interior_list, thingsdone);
+			int p = strat_endsolver_and_solution_reducer_logic(ctx, &retholder, &interior_list, thingsdone);
 			if (*thingsdone) {
-				if (myruninfo.SCREEN == 3) myprintfn(2, "ENDSOLVER: did something!!\n");
+				if (ctx->info->SCREEN == 3) myprintfn(2, "ENDSOLVER: did something!!\n");
 				*modeflag = 2;
 				return p;
 			}
@@ -1092,20 +1211,20 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 			// solver progress / estimated mines / actual mines
 			// somehow incorporate chain length? how hard is it to count the mines in each chain individually?
 			// TODO: eventually implement a "bias function" to correct for mis-estimating, probably depend on whole game progress, chain size, estimated mines
-			for (std::list<class cell *>::iterator cellit = interior_list.begin(); cellit != interior_list.end(); cellit++) {
+			for (std::vector<class cell *>::iterator cellit = interior_list.begin(); cellit != interior_list.end(); cellit++) {
 				if ((*cellit)->value == MINE)
 				interiormines++;
 			}
-			int bordermines = mygame.get_mines_remaining() - interiormines;
+			int bordermines = g->get_mines_remaining() - interiormines;
 
-			if (myruninfo.SCREEN == 3) myprintfn(2, "DEBUG: in smart-guess, border_avg/ceiling/border_actual = %.3f / %i / %i\n", border_allocation, mygame.get_mines_remaining(), bordermines);
+			if (ctx->info->SCREEN == 3) myprintfn(2, "DEBUG: in smart-guess, border_avg/ceiling/border_actual = %.3f / %i / %i\n", border_allocation, g->get_mines_remaining(), bordermines);
 			gstats->smartguess_attempts++;
 			gstats->smartguess_diff += (border_allocation - float(bordermines)); // accumulating a less-negative number
 			////////////////////////////////////////////////////////////////////////
 
 
-			border_allocation = min(border_allocation, mygame.get_mines_remaining()); // border_alloc must be <= mines_remaining
-			interior_risk = (float(mygame.get_mines_remaining()) - border_allocation) / float(interior_list.size()) * 100.;
+			border_allocation = min(border_allocation, g->get_mines_remaining()); // border_alloc must be <= mines_remaining
+			interior_risk = (float(g->get_mines_remaining()) - border_allocation) / float(interior_list.size()) * 100.;
 		}
 
 	} // end of "finding likely border mine allocation to determine interior risk" section
@@ -1115,19 +1234,19 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 	std::pair<float, std::list<class cell *>> myriskreturn;
 	std::list<class cell *> clearmelist;
 	std::list<class cell *> flagmelist;
-	if(GUESSING_MODE_var != 2) {
+	if(ctx->guessing_mode != 2) {
 		// Option A: the risk for each individual cell is the avg/max risk from any of the pods it belongs to
 		// smartguess/normal and smartguess/endsolver
 		// iterate over "master chain", storing risk information into 'riskholder' (only read cell_list since it also holds the links)
 		for (std::list<struct pod>::iterator podit = master_chain.podlist.begin(); podit != master_chain.podlist.end(); podit++) {
 			float podrisk = podit->risk();
-			for (int i = 0; i < podit->cell_list.size(); i++) {
-				myriskholder.addrisk(podit->cell_list[i], podrisk);
+			for (int i = 0; i < (int)podit->cell_list.size(); i++) {
+				ctx->risk.addrisk(podit->cell_list[i], podrisk);
 			}
 		}
 	} else {
 		// for each PR in retholder,
-		for (int a = 0; a < retholder.size(); a++) {
+		for (int a = 0; a < (int)retholder.size(); a++) {
 			if (use_endsolver) {
 				// perfectmode/endsolver
 				// create the aggregate info structure in the PR from the exhaustive list of solutions
@@ -1136,7 +1255,7 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 				// for each pod in the corresponding chain,
 				for (std::list<struct pod>::iterator podit = listofchains[a].podlist.begin(); podit != listofchains[a].podlist.end(); podit++) {
 					// for each cell in that pod,
-					for (int b = 0; b < podit->cell_list.size(); b++) {
+					for (int b = 0; b < (int)podit->cell_list.size(); b++) {
 						retholder[a].add_aggregate(podit->cell_list[b], 0);
 					}
 				}
@@ -1167,27 +1286,27 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 				} else if (cellrisk == 0.) {
 					clearmelist.push_back(aggit->me);
 				} else {
-					myriskholder.addrisk(aggit->me, cellrisk);
+					ctx->risk.addrisk(aggit->me, cellrisk);
 				}
 			}
 		}
 	}
 	// find the lowest risk of anything i've entered into the riskholder, as well as the cells that correspond to it
-	// also clears/resets the myriskholder object for next time
+	// also clears/resets the riskholder object for next time
 	// need to do this unconditionally so the struct is clear for use next time!!
-	myriskreturn = myriskholder.findminrisk();
+	myriskreturn = ctx->risk.findminrisk();
 	if (flagmelist.size() || clearmelist.size()) {
 		// flag the flagme and clear the clearme and RETURN
 		*modeflag = 2;
-		if (myruninfo.SCREEN == 3) myprintfn(2, "DEBUG: from aggregate data, found %i clear and %i flag (but counts as endsolver)\n", clearmelist.size(), flagmelist.size());
+		if (ctx->info->SCREEN == 3) myprintfn(2, "DEBUG: from aggregate data, found %i clear and %i flag (but counts as endsolver)\n", clearmelist.size(), flagmelist.size());
 		for (std::list<class cell *>::iterator cit = clearmelist.begin(); cit != clearmelist.end(); cit++) { // clear-list
 			*thingsdone += 1;
-			if (mygame.reveal(*cit) == -1) {
+			if (g->reveal(*cit) == -1) {
 				myprintfn(2, "ERR: Unexpected loss during aggregate info analysis!!\n"); assert(0); return -2;
 			}
 		}
 		for (std::list<class cell *>::iterator fit = flagmelist.begin(); fit != flagmelist.end(); fit++) { // flag-list
-			int r = mygame.set_flag(*fit);
+			int r = g->set_flag(*fit);
 			*thingsdone += bool(r);
 			if (r == -1) { return 1; } else if (r == 2) { assert(0); return -2; }
 		}
@@ -1198,7 +1317,7 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 
 
 	// step 11: decide between border and interior, call 'rand_from_list' and return
-	if (myruninfo.SCREEN == 3) myprintfn(2, "DEBUG: in smart-guess, interior_risk = %.3f%%, border_risk = %.3f%%\n", interior_risk, myriskreturn.first);
+	if (ctx->info->SCREEN == 3) myprintfn(2, "DEBUG: in smart-guess, interior_risk = %.3f%%, border_risk = %.3f%%\n", interior_risk, myriskreturn.first);
 	//if (interior_risk == 100.) {
 	//	// unlikely but plausible (note: if interior is empty, interior_risk will be set at 150)
 	//	// this is eclipsed by the 'maxguess' section, unless this scenario happens before the end-game
@@ -1210,13 +1329,13 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 		gstats->luck_value_mult *= (1. - (interior_risk / 100.)); // turn it from 'chance its a mine' to 'chance its safe'
 		gstats->luck_value_sum += (1. - (interior_risk / 100.)); // turn it from 'chance its a mine' to 'chance its safe'
 		// in smartguess, i don't care about how many cells are uncovered from one guess, just if it is loss or continue
-		int r = mygame.reveal(rand_from_list(&interior_list));
+		int r = g->reveal(rand_from_list(&interior_list, &g->rng));
 		return ((r==-1) ? -1 : 0); // if -1, return -1; otherwise, return 0
 	} else {
 		// border is safer, or they are tied
 		gstats->luck_value_mult *= (1. - (myriskreturn.first / 100.)); // turn it from 'chance its a mine' to 'chance its safe'
 		gstats->luck_value_sum += (1. - (myriskreturn.first / 100.)); // turn it from 'chance its a mine' to 'chance its safe'
-		int r = mygame.reveal(rand_from_list(&myriskreturn.second));
+		int r = g->reveal(rand_from_list(&myriskreturn.second, &g->rng));
 		return ((r == -1) ? -1 : 0); // if -1, return -1; otherwise, return 0
 	}
 	return 0; // this should be impossible to hit
@@ -1252,10 +1371,11 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag) {
 // perfectmode/normal: returns aggregate data for each cell in the chain + list of solutionvalues w/ weights
 // perfectmode/endsolver: returns exhaustive list of all roadmaps, WAY more memory usage, dont even worry about optimizing it
 //		^ don't store/calculate aggregate data, synthesize the data after step 8 because step 8 will eliminate some of the solutions
-struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above, struct chain * mychain, bool use_endsolver) {
-	bool use_smartguess = (GUESSING_MODE_var == 2);
+struct podwise_return podwise_recurse(struct solvercontext * ctx, int rescan_counter, int mines_from_above, struct chain * mychain, bool use_endsolver) {
+	class game * g = ctx->g;
+	bool use_smartguess = (ctx->guessing_mode == 2);
 	// step 0: are we done?
-	if (mines_from_above > mygame.get_mines_remaining()) {
+	if (mines_from_above > (int)g->get_mines_remaining()) {
 		// means that the scenario above this is invalid; return a completely empty PR to signal this
 		return podwise_return();
 	} else if (mychain->podlist.empty()) {
@@ -1290,7 +1410,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 			// for each solution,
 			for (std::list<struct solutionobj>::iterator solit = r.solutions.begin(); solit != r.solutions.end(); solit++) {
 				// for each int in ret.front(),
-				for (int f = 0; f < ret.front().size(); f++) {
+				for (int f = 0; f < (int)ret.front().size(); f++) {
 					// use that int as index in cell_list and push to the end of the solution in question
 					solit->allocation.push_back(mychain->podlist.front().cell_list[ret.front()[f]]);
 				}
@@ -1306,7 +1426,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 		rescan_counter++;
 	} else {
 		rescan_counter = 0;
-		int r = mychain->identify_chains();
+		int r = mychain->identify_chains(&ctx->chain_todo);
 		if (r > 1) {
 			// if it has broken into 2 or more distinct chains, seperate them to operate recursively on each! much faster than the whole
 			std::vector<struct chain> chain_list = mychain->sort_into_chains(r, false); // where i'll be sorting them into
@@ -1318,7 +1438,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 			int alloc_product = 1;
 			for (int s = 0; s < r; s++) {
 				struct podwise_return asdf = podwise_recurse(rescan_counter, &(chain_list[s]), use_smartguess, use_endsolver);
-				sum += asdf.avg();
+				sum += asdf.avg(g->get_mines_remaining());
 				effort_sum += asdf.effort;
 				alloc_product *= asdf.total_alloc();
 			}
@@ -1326,7 +1446,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 			struct podwise_return asdf2 = podwise_return(sum, alloc_product);
 			asdf2.effort = effort_sum;
 			if (effort_sum > RECURSION_SAFETY_LIMITER)
-				recursion_safety_valve = true;
+				ctx->recursion_safety_valve = true;
 			return asdf2;
 		}
 		// if r == 1, then we're still in one contiguous chain. just continue as planned.
@@ -1443,7 +1563,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 			// for each solution,
 			for (std::list<struct solutionobj>::iterator solit = thislvl.solutions.begin(); solit != thislvl.solutions.end(); solit++) {
 				// for each int in ret.front(),
-				for (int f = 0; f < ret.front().size(); f++) {
+				for (int f = 0; f < (int)ret.front().size(); f++) {
 					// use that int as index in cell_list and push to the end of the solution in question
 					solit->allocation.push_back(frontpod->cell_list[ret.front()[f]]);
 				}
@@ -1547,7 +1667,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 						// each podwise_return object uses one entry from 'ret', the front() one
 						for (std::list<struct podwise_return>::iterator prit = copyholder.begin(); prit != copyholder.end(); prit++) {
 							// for each int in ret.front(),
-							for (int f = 0; f < ret.front().size(); f++) {
+							for (int f = 0; f < (int)ret.front().size(); f++) {
 								// use that int as index in cell_list and push to the end of the solution in question
 								*prit += activepod->cell_list[ret.front()[f]];
 							}
@@ -1593,7 +1713,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 
 		// step 4: recurse! when it returns, combine the 'lower' info with 'thislvl' info (VERTICAL combining)
 		// with first 3 modes, there is only one solutions entry thislvl; with perfectmode/endsolver, all solutions have the same answer value
-		lower = podwise_recurse(rescan_counter, (thislvl.solutions.front().answer + mines_from_above), &copychain, use_endsolver);
+		lower = podwise_recurse(ctx, rescan_counter, (thislvl.solutions.front().answer + mines_from_above), &copychain, use_endsolver);
 		
 		// NOTE: if lower.solutions.empty(), that means that thislvl (this scenario) is invalid!!
 		// either this scenario directly places more mines than there are remaining in the game, or all branches that descend from this one
@@ -1662,7 +1782,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 		
 
 		// if the safety valve has been activated, only try RECURSION_SAFE_WIDTH valid scenarios each level at most
-		if (recursion_safety_valve && (whichscenarioSUCCESSFUL >= RECURSION_SAFE_WIDTH)) { break; }
+		if (ctx->recursion_safety_valve && (whichscenarioSUCCESSFUL >= RECURSION_SAFE_WIDTH)) { break; }
 		whichscenarioSUCCESSFUL++; // don't want this to inc on an invalid scenario
 	LABEL_END_OF_THE_SCENARIO_LOOP:
 		whichscenarioREALLY++; // need to have something here or else the label/goto gets all whiney
@@ -1689,7 +1809,7 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 	}
 
 	// if I have spent too much effort calculating all the possibilities, then trip the safety valve
-	if (retval.effort > RECURSION_SAFETY_LIMITER) { recursion_safety_valve = true; }
+	if (retval.effort > RECURSION_SAFETY_LIMITER) { ctx->recursion_safety_valve = true; }
 	return retval;
 }
 
@@ -1705,14 +1825,18 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 // veryveryvery simple to understand. internally identifies and flags/clears cells. also responsible for setting state to "satisfied"
 // when appropriate. no special stats to track here, except for the "singlecell total action count".
 // return: 1=win/-1=loss/0=continue (cannot lose tho, unless something is seriously out of whack)
-int strat_singlecell(class cell * me, int * thingsdone) {
-	std::vector<class cell *> unk = mygame.filter_adjacent(me, UNKNOWN);
+int strat_singlecell(struct solvercontext * ctx, class cell * me, int * thingsdone) {
+	class game * g = ctx->g;
+	// neither strategy can do anything unless effective = 0 or effective = # unknowns, the live count tells me that in O(1)
+	if (!singlecell_can_act(g, me)) { return 0; }
+	struct adjlist unk;
+	g->filter_adjacent(me, UNKNOWN, &unk);
 	int r = 0;
 	// strategy 1: if an X-adjacency cell is next to X unknowns, flag them all
-	if ((me->get_effective() != 0) && (me->get_effective() == unk.size())) {
+	if ((g->view.effective_of(me) != 0) && (g->view.effective_of(me) == unk.size())) {
 		// flag all unknown cells
 		for (int i = 0; i < unk.size(); i++) {
-			r = mygame.set_flag(unk[i]);
+			r = g->set_flag(unk[i]);
 			*thingsdone += bool(r); // inc by # of cells flagged (one)
 			if (r == -1) { return 1; } // validated win! time to return!
 		}
@@ -1720,10 +1844,10 @@ int strat_singlecell(class cell * me, int * thingsdone) {
 	}
 
 	// strategy 2: if an X-adjacency cell is next to X flags, all remaining unknowns are NOT flags and can be revealed
-	if (me->get_effective() == 0) {
+	if (g->view.effective_of(me) == 0) {
 		// reveal all adjacent unknown squares
 		for (int i = 0; i < unk.size(); i++) {
-			r = mygame.reveal(unk[i]);
+			r = g->reveal(unk[i]);
 			if (r == -1) {
 				myprintfn(2, "ERR: Unexpected loss during SC satisfied-reveal, must investigate!!\n");
 				assert(1 == 2);
@@ -1731,10 +1855,14 @@ int strat_singlecell(class cell * me, int * thingsdone) {
 			}
 			*thingsdone += r; // inc by # of cells revealed
 		}
-		me->set_status_satisfied();
+		g->set_satisfied(me);
 	}
 	return 0;
 }
+// read-only: would strat_singlecell do anything to this cell right now? (flag, reveal, or just mark it satisfied)
+bool singlecell_can_act(class game * g, class cell * me) {
+	return (g->view.effective_of(me) == 0) || (g->view.effective_of(me) == g->count_unknown_around(me));
+}
 
 
 
@@ -1742,48 +1870,45 @@ int strat_singlecell(class cell * me, int * thingsdone) {
 // looks for a specific arrangement of visible/unknown cells; if found, I can clear up to 2 cells.
 // unlike the other strategies, this isn't based in logic so much... this is just a pattern I noticed.
 // return: 1=win/-1=loss/0=continue (except cannot win, ever, and cannot lose unless something is seriously out of whack)
-int strat_121_cross(class cell * center, struct game_stats * gstats, int * thingsdone) {
-	if (center->get_effective() != 2) { return 0; }
-	std::vector<class cell *> adj = mygame.get_adjacent(center);
-	if (adj.size() == 3) // must be in a corner
-		return 0;
+int strat_121_cross(struct solvercontext * ctx, class cell * center, struct game_stats * gstats, int * thingsdone) {
+	class game * g = ctx->g;
+	class cell * c1; class cell * c2;
+	if (!find_121_cross(g, center, &c1, &c2)) { return 0; }
+	int r = g->reveal(c1);
+	int s = g->reveal(c2);
+	if ((r == -1) || (s == -1)) {
+		myprintfn(2, "ERR: Unexpected loss during MC 121-cross, must investigate!!\n"); assert(0);
+		return -1;
+	}
+	gstats->strat_121 += (r != 0 || s != 0);
+	*thingsdone += (r + s);
+	return 0;
+}
+// read-only half of 121-cross: if the pattern is here, return true and the two cells it would reveal (either may be NULL)
+bool find_121_cross(class game * g, class cell * center, class cell ** c1, class cell ** c2) {
+	if (g->view.effective_of(center) != 2) { return false; }
+	if (g->adj_count[center - &g->field[0]] == 3) // must be in a corner
+		return false;
 
-	int r = 0; int s = 0;
-	class cell * right =mygame.cellptr((center->x) + 1, center->y);
-	class cell * left =	mygame.cellptr((center->x) - 1, center->y);
-	class cell * down = mygame.cellptr(center->x, (center->y) + 1);
-	class cell * up =	mygame.cellptr(center->x, (center->y) - 1);
+	class cell * right =g->cellptr(g->xof(center) + 1, g->yof(center));
+	class cell * left =	g->cellptr(g->xof(center) - 1, g->yof(center));
+	class cell * down = g->cellptr(g->xof(center), g->yof(center) + 1);
+	class cell * up =	g->cellptr(g->xof(center), g->yof(center) - 1);
 
 	// assuming 121 in horizontal line:
 	if ((right != NULL) && (left != NULL) && (right->get_status() == VISIBLE) && (left->get_status() == VISIBLE)
-		&& (right->get_effective() == 1) && (left->get_effective() == 1)) {
-		r = mygame.reveal(down);
-		s = mygame.reveal(up);
-		if ((r == -1) || (s == -1)) {
-			myprintfn(2, "ERR: Unexpected loss during MC 121-cross, must investigate!!\n"); assert(0);
-			return -1;
-		} else {
-			gstats->strat_121 += (r != 0 || s != 0);
-			*thingsdone += (r + s);
-			return 0;
-		}
+		&& (g->view.effective_of(right) == 1) && (g->view.effective_of(left) == 1)) {
+		*c1 = down; *c2 = up;
+		return true;
 	}
 
 	// assuming 121 in vertical line:
 	if ((down != NULL) && (up != NULL) && (down->get_status() == VISIBLE) && (up->get_status() == VISIBLE)
-		&& (down->get_effective() == 1) && (up->get_effective() == 1)) {
-		r = mygame.reveal(right);
-		s = mygame.reveal(left);
-		if ((r == -1) || (s == -1)) {
-			myprintfn(2, "ERR: Unexpected loss during MC 121-cross, must investigate!!\n"); assert(0);
-			return -1;
-		} else {
-			gstats->strat_121 += (r != 0 || s != 0);
-			*thingsdone += (r + s);
-			return 0;
-		}
+		&& (g->view.effective_of(down) == 1) && (g->view.effective_of(up) == 1)) {
+		*c1 = right; *c2 = left;
+		return true;
 	}
-	return 0;
+	return false;
 }
 
 
@@ -1795,34 +1920,39 @@ int strat_121_cross(class cell * center, struct game_stats * gstats, int * thing
 // Compare against 5x5 region minus corners.
 // X(other) = 1/2/3/4,  Z = 1/2/3/4/5/6
 // return: 1=win/-1=loss/0=continue (except cannot lose here because it doesn't reveal cells here)
-int strat_nonoverlap_flag(class cell * center, struct game_stats * gstats, int * thingsdone) {
-	if ((center->get_effective() < 2) || (center->get_effective() == 8)) { return 0; } // center must be 2-7
-	std::vector<class cell *> me_unk = mygame.filter_adjacent(center, UNKNOWN);
-	std::vector<class cell *> other_unk;
+int strat_nonoverlap_flag(struct solvercontext * ctx, class cell * center, struct game_stats * gstats, int * thingsdone) {
+	class game * g = ctx->g;
+	struct adjlist me_only;
+	if (!find_nonoverlap_flag(g, center, &me_only)) { return 0; }
+	gstats->strat_nov_flag++;
+	for (int i = 0; i < me_only.size(); i++) {
+		int r = g->set_flag(me_only[i]);
+		*thingsdone += bool(r); // inc once for each flag placed
+		if (r == -1) { return 1; }
+	}
+	return 0;
+}
+// read-only half of nonoverlap-flag: if a match is found, return true and the Z cells that must be mines
+bool find_nonoverlap_flag(class game * g, class cell * center, struct adjlist * me_only) {
+	if ((g->view.effective_of(center) < 2) || (g->view.effective_of(center) == 8)) { return false; } // center must be 2-7
+	struct adjlist me_unk, other_unk, other_only, overlap; // all on the stack, nothing allocated
+	g->filter_adjacent(center, UNKNOWN, &me_unk);
 	for (int b = -2; b < 3; b++) { for (int a = -2; a < 3; a++) {
 		if (((a == -2 || a == 2) && (b == -2 || b == 2)) || (a == 0 && b == 0)) { continue; } // skip myself and also the corners
-		class cell * other = mygame.cellptr(center->x + a, center->y + b);
+		class cell * other = g->cellptr(g->xof(center) + a, g->yof(center) + b);
 		if ((other == NULL) || (other->get_status() != VISIBLE)) { continue; }			// must exist and be already revealed
-		if ((other->get_effective() == 0) || (other->get_effective() > 4)) { continue; }	// other must be 1/2/3/4
-		int z = center->get_effective() - other->get_effective();
+		if ((g->view.effective_of(other) == 0) || (g->view.effective_of(other) > 4)) { continue; }	// other must be 1/2/3/4
+		int z = g->view.effective_of(center) - g->view.effective_of(other);
 		if (z < 1) { continue; }														// z must be 1 or greater
 
-		other_unk = mygame.filter_adjacent(other, UNKNOWN);
+		g->filter_adjacent(other, UNKNOWN, &other_unk);
 
-		std::vector<std::vector<class cell *>> nonoverlap = extract_overlap(me_unk, other_unk);
+		extract_overlap(me_unk, other_unk, me_only, &other_only, &overlap);
 		// checking if OTHER is a subset of ME, AKA ME has some extra unique cells
-		if (nonoverlap[0].size() == z) {
-			gstats->strat_nov_flag++;
-			for (int i = 0; i < z; i++) {
-				int r = mygame.set_flag(nonoverlap[0][i]);
-				*thingsdone += bool(r); // inc once for each flag placed
-				if (r == -1) { return 1; }
-			}
-			return 0;
-		}
+		if (me_only->size() == z) { return true; }
 	}}
 
-	return 0;
+	return false;
 }
 
 
@@ -1833,40 +1963,69 @@ int strat_nonoverlap_flag(class cell * center, struct game_stats * gstats, int *
 //square with the same value, then the non-overlap section can be safely revealed!
 //Compare against any other same-value cell in the 5x5 region minus corners
 // return: 1=win/-1=loss/0=continue (except cannot win, ever, and cannot lose unless something is seriously out of whack)
-int strat_nonoverlap_safe(class cell * center, struct game_stats * gstats, int * thingsdone) {
-	if (center->get_effective() > 3) { return 0; } // only works for center = 1/2/3
-	std::vector<class cell *> me_unk = mygame.filter_adjacent(center, UNKNOWN);
-	std::vector<class cell *> other_unk;
-	int retme = 0;
+int strat_nonoverlap_safe(struct solvercontext * ctx, class cell * center, struct game_stats * gstats, int * thingsdone) {
+	class game * g = ctx->g;
+	struct adjlist other_only;
+	if (!find_nonoverlap_safe(g, center, &other_only)) { return 0; }
+	int retme_sub = 0;
+	for (int i = 0; i < other_only.size(); i++) {
+		int r = g->reveal(other_only[i]);
+		if (r == -1) {
+			myprintfn(2, "ERR: Unexpected loss during MC nonoverlap-safe, must investigate!!\n"); assert(0);
+			return -1;
+		}
+		retme_sub += r;
+	}
+	*thingsdone += retme_sub; // increment by how many were cleared
+	gstats->strat_nov_safe += bool(retme_sub);
+	return 0;
+}
+// read-only half of nonoverlap-safe: if a match is found, return true and the cells that are safe to reveal
+bool find_nonoverlap_safe(class game * g, class cell * center, struct adjlist * other_only) {
+	if (g->view.effective_of(center) > 3) { return false; } // only works for center = 1/2/3
+	struct adjlist me_unk, other_unk, me_only, overlap; // all on the stack, nothing allocated
+	g->filter_adjacent(center, UNKNOWN, &me_unk);
 	for (int b = -2; b < 3; b++) { for (int a = -2; a < 3; a++) {
 		if (((a == -2 || a == 2) && (b == -2 || b == 2)) || (a == 0 && b == 0)) { continue; } // skip myself and also the corners
-		class cell * other = mygame.cellptr(center->x + a, center->y + b);
+		class cell * other = g->cellptr(g->xof(center) + a, g->yof(center) + b);
 		if ((other == NULL) || (other->get_status() != VISIBLE)) { continue; }	// must exist and be already revealed
-		if (center->get_effective() != other->get_effective()) { continue; }	// the two being compared must have same effective value
-		other_unk = mygame.filter_adjacent(other, UNKNOWN);
-		if (me_unk.size() >= other_unk.size()) { continue; } // shortcut, can't be subset if it's bigger or equal
+		if (g->view.effective_of(center) != g->view.effective_of(other)) { continue; }	// the two being compared must have same effective value
+		if (me_unk.size() >= g->count_unknown_around(other)) { continue; } // shortcut, can't be subset if it's bigger or equal
+		g->filter_adjacent(other, UNKNOWN, &other_unk);
 
-		std::vector<std::vector<class cell *>> nonoverlap = extract_overlap(me_unk, other_unk);
+		extract_overlap(me_unk, other_unk, &me_only, other_only, &overlap);
 		// checking if ME is a subset of OTHER
-		if (nonoverlap[0].empty() && !(nonoverlap[1].empty())) {
-			int retme_sub = 0;
-			for (int i = 0; i < nonoverlap[1].size(); i++) {
-				int r = mygame.reveal(nonoverlap[1][i]);
-				if (r == -1) {
-					myprintfn(2, "ERR: Unexpected loss during MC nonoverlap-safe, must investigate!!\n"); assert(0);
-					return -1;
-				}
-				retme_sub += r;
-			}
-			*thingsdone += retme_sub; // increment by how many were cleared
-			gstats->strat_nov_safe += bool(retme_sub);
-			return 0;
-			//me_unk = mygame.filter_adjacent(center, UNKNOWN); // update me_unk, then continue iterating thru the 5x5
-		}
+		if (me_only.empty() && !(other_only->empty())) { return true; }
 	}}
 
-	return 0;
+	return false;
+}
+// read-only: would any of the three two-cell strategies do anything to this cell right now?
+bool twocell_can_act(class game * g, class cell * me) {
+	class cell * c1; class cell * c2;
+	struct adjlist found;
+	if (find_121_cross(g, me, &c1, &c2)) {
+		// it only stops at the first pattern it finds, and does nothing if those cells are already open
+		if (((c1 != NULL) && (c1->get_status() == UNKNOWN)) || ((c2 != NULL) && (c2->get_status() == UNKNOWN))) { return true; }
+	}
+	return find_nonoverlap_flag(g, me, &found) || find_nonoverlap_safe(g, me, &found);
 }
 
 
 
+// tiled logic: work out in parallel which cells of 'round' could possibly act (the expensive part, it reads the board and writes
+// nothing), so the serial pass only has to run the real strategy on those cells plus any cell whose neighborhood has changed
+// since. the serial pass still goes in the same order as always, so the game comes out exactly the same as without this.
+// returns false if the round is too small to bother (or there's only one thread); then every cell is a candidate
+bool find_round_candidates(struct solvercontext * ctx, const std::vector<class cell *> & round, bool (*can_act)(class game *, class cell *), std::vector<char> * out) {
+	if (!ctx->parallel() || (round.size() <= LOGIC_TILE_SIZE)) { return false; }
+	class game * g = ctx->g;
+	out->resize(round.size());
+	ctx->run_tiled((int)round.size(), [&](int lo, int hi) {
+		for (int i = lo; i < hi; i++) {
+			class cell * me = round[i];
+			(*out)[i] = (me->get_status() == VISIBLE) && can_act(g, me);
+		}
+	});
+	return true;
+}
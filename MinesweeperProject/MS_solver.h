@@ -14,19 +14,14 @@
 #include <cassert> // so it aborts when something wierd happens (but its optimized away in 'release' mode)
 #include <algorithm> // for pod-based intelligent recursion
 #include <utility> // for 'pair' objects
+#include <unordered_map> // root->pod lookup for the master chain
+#include <functional> // tiled jobs
 #include <Windows.h> // adds min() and max() macros
 
 
 
 
 
-extern class runinfo myruninfo;
-extern class game mygame;
-extern int GUESSING_MODE_var;
-
-
-
-
 /* terminology:
 solution: one way to satisfy a chain
 	answer: how many mines are in a solution
@@ -81,7 +76,7 @@ struct podwise_return {
 	inline struct podwise_return& operator+=(const std::list<class cell *>& addlist);
 	inline struct podwise_return& operator*=(const int& rhs);
 	inline struct podwise_return& operator+=(const int& rhs);
-	float avg();
+	float avg(int mines_remaining);
 	float max_val();
 	float min_val();
 	int total_alloc();
@@ -105,7 +100,7 @@ struct link {
 // almost certain to have some overlap with other pods; these are recorded as 'links'
 struct pod {
 	pod() {};
-	pod(class cell * new_root);
+	pod(class cell * new_root, class game * g);
 
 	class cell * root;  //the visible adjacency-cell the pod is based on (or one of them if there were dupes)
 	int mines;			//how many mines are in the pod
@@ -133,10 +128,18 @@ struct chain {
 
 	std::list<struct pod>::iterator root_to_pod(class cell * linked_root);
 	std::list<struct pod>::iterator int_to_pod(int f);
-	std::vector<std::list<struct pod>::iterator> get_5x5_around(std::list<struct pod>::iterator center, bool include_corners);
+	std::vector<std::list<struct pod>::iterator> get_5x5_around(std::list<struct pod>::iterator center, bool include_corners, class game * g);
 	std::vector<struct chain> sort_into_chains(int r, bool reduce);
-	int identify_chains();
-	void identify_chains_recurse(int idx, struct pod * me);
+	int identify_chains(std::vector<struct pod *> * todo);
+	void identify_chains_fill(int idx, struct pod * me, std::vector<struct pod *> * todo);
+
+	// optional root->pod lookup, so root_to_pod doesn't walk the whole list; only the master chain bothers to build it
+	// copies of a chain don't get it (the iterators would point into the wrong list), they fall back to the walk
+	std::unordered_map<class cell *, std::list<struct pod>::iterator> root_index;
+	void index_roots();
+	std::list<struct pod>::iterator erase_pod(std::list<struct pod>::iterator killme);
+	chain(const struct chain & other) : podlist(other.podlist) {}
+	struct chain & operator= (const struct chain & other) { podlist = other.podlist; root_index.clear(); return *this; }
 };
 
 
@@ -144,14 +147,20 @@ struct chain {
 // an immitation of the 'field' object, to be allocated globally?? and reused each time the pod-smart-guess is used
 // holds the risk info for each cell, will calculate the border cells with the lowest risk
 struct riskholder {
-	riskholder() {};
-	riskholder(int x, int y);
+	riskholder() { g = NULL; };
+	riskholder(class game * newgame);
 
-	std::vector<std::vector<std::vector<float>>> riskarray; // immitation of the 'field' for holding risk info, can be quickly accessed with x and y
+	class game * g; // the board whose cells these are
+
+	// sparse: only the cells that actually got a risk have an entry, so finding the min never walks the whole field
+	struct riskentry { class cell * me; float sum; float worst; int count; };
+	std::vector<int> slot; // indexed same as game::field, where that cell's entry is in 'entries' (or -1)
+	std::vector<struct riskentry> entries; // one for each cell touched since the last findminrisk
 
 	void addrisk(class cell * foo, float newrisk);
 	std::pair<float, std::list<class cell *>> findminrisk();
-	float finalrisk(int x, int y);
+	float finalrisk(struct riskentry * e);
+	bool sort_entries(const struct riskentry & a, const struct riskentry & b);
 };
 
 
@@ -166,6 +175,50 @@ struct scenario {
 };
 
 
+// everything the solver needs to play one board: the board itself, the settings, and all the scratch space that
+// used to be globals or function-statics. one per board being played, so several boards can be solved at once
+// (on different threads) without stepping on each other. the solver never looks at mygame/myruninfo directly
+struct solvercontext {
+	solvercontext(class game * newgame, class runinfo * newinfo, int newmode, bool newfindz, class threadpool * newpool);
+
+	class game * g;				// the board
+	class runinfo * info;		// only for SCREEN, to decide what debug info to print
+	class threadpool * pool;	// the tiled logic runs on this; NULL or a pool of 1 = everything serial on the calling thread
+	int guessing_mode;			// 0=random, 1=smartguess, 2=perfectmode
+	bool find_early_zeros;		// 'hunting' method: reveal only zeroes until solving gets underway
+	bool recursion_safety_valve; // if recursion goes down a rabbithole, start taking shortcuts
+
+	struct riskholder risk;		// smartguess's per-cell risk totals, sized to the board
+
+	// the chain builder's stand-in for "no pod here"
+	class cell dummycell;
+	struct pod dummypod;
+	std::list<struct pod> dummylist;
+	std::list<struct pod>::iterator dummyitr;
+
+	// chain builder scratch, kept between calls so it doesn't have to be reallocated every time
+	std::vector<class cell *> frontier;
+	std::vector<struct pod> built;
+	std::vector<std::list<struct pod>::iterator> podvec; // also used by smartguess step 5, after the builder is done with it
+	std::vector<char> can_act;
+	std::vector<int> touched;
+	int touched_pass;
+	std::vector<struct pod *> chain_todo; // identify_chains worklist
+	class cellset interior;		// smartguess's list of unknown cells that aren't in any pod, refilled every guess
+
+	// new settings, and resize for the board if it was re-init'd at a different size; all the scratch space is kept
+	void reset(int newmode, bool newfindz, class threadpool * newpool);
+	// is there more than 1 thread to split the tiled logic across?
+	bool parallel();
+	// cut [0, nitems) into LOGIC_TILE_SIZE tiles and call job(lo, hi) on each, spread across the pool (or all at once, if serial)
+	void run_tiled(int nitems, const std::function<void(int, int)> & job);
+
+private:
+	solvercontext(const struct solvercontext &); // not copyable, the dummy iterator points into dummylist
+	struct solvercontext & operator= (const struct solvercontext &);
+};
+
+
 
 
 
@@ -204,19 +257,22 @@ inline int factorial(int x);
 // may identify some cells as "definite safe" or "definite mine", and will reveal/flag them internally
 // if no cells are flagged/cleared, will output the master chain thru input arg for passing to full recursive function below
 // return: 1=win/-1=loss/0=continue (winning is rare but theoretically possible, but cannot lose unless something is seriously out of whack)
-int strat_multicell_logic_and_chain_builder(struct chain * buildme, int * thingsdone);
+int strat_multicell_logic_and_chain_builder(struct solvercontext * ctx, struct chain * buildme, int * thingsdone);
+// read-only half of step 2 of the chain builder: would the step-2 loop body change anything if it ran on this pod right now?
+// used by the tiled version of step 2 to find the pods worth running, must be kept in sync with step 2
+bool multicell_pod_can_act(struct chain * buildme, std::list<struct pod>::iterator podit, std::list<struct pod>::iterator dummyitr, class game * g);
 // smartguess: searches for chain solutions with only one allocation (unique) to apply
 // perfectmode: ^ plus, if non-unique solution is found, eliminate all other solutions to that chain
 //				^ plus, searches for chain solutions that are definitely invalid and eliminates them
 // return: 1=win/-1=loss/0=continue (cannot lose unless something is seriously out of whack)
 // but, it only causes smartguess to return to the main play_game level if this function adds to *thingsdone
-int strat_endsolver_and_solution_reducer_logic(std::vector<struct podwise_return> * prvect, std::list<class cell *> * interior_list, int * thingsdone);
+int strat_endsolver_and_solution_reducer_logic(struct solvercontext * ctx, std::vector<struct podwise_return> * prvect, class cellset * interior_list, int * thingsdone);
 // laboriously determine the % risk of each unknown cell and choose the one with the lowest risk to reveal
 // can completely solve the puzzle, too; if it does, it clears/flags everything it knows for certain
 // doesn't return cells, instead clears/flags them internally
 // modeflag: 0=guess, 1=multicell, 2=endsolver
 // return: 1=win/-1=loss/0=continue/-2=unexpected loss (winning is unlikely but possible)
-int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag);
+int smartguess(struct solvercontext * ctx, struct game_stats * gstats, int * thingsdone, int * modeflag);
 // recursively operates on a interconnected 'chain' of pods, and returns the list of all allocations it can find.
 // 'recursion_safety_valve' is set whenever it would return something resulting from 10k or more solutions, then from that point
 //		till the chain is done, it checks max 2 scenarios per level.
@@ -225,7 +281,7 @@ int smartguess(struct game_stats * gstats, int * thingsdone, int * modeflag);
 // perfectmode/normal: returns aggregate data for each cell in the chain + list of solutionvalues w/ weights
 // perfectmode/endsolver: returns exhaustive list of all roadmaps, WAY more memory usage, dont even worry about optimizing it
 //		^ don't store/calculate aggregate data, synthesize the data after step 8 because step 8 will eliminate some of the solutions
-struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above, struct chain * mychain, bool use_endsolver);
+struct podwise_return podwise_recurse(struct solvercontext * ctx, int rescan_counter, int mines_from_above, struct chain * mychain, bool use_endsolver);
 
 
 
@@ -236,7 +292,9 @@ struct podwise_return podwise_recurse(int rescan_counter, int mines_from_above,
 // veryveryvery simple to understand. internally identifies and flags/clears cells. also responsible for setting state to "satisfied"
 // when appropriate. no special stats to track here, except for the "singlecell total action count".
 // return: 1=win/-1=loss/0=continue (cannot lose tho, unless something is seriously out of whack)
-int strat_singlecell(class cell * me, int * thingsdone);
+int strat_singlecell(struct solvercontext * ctx, class cell * me, int * thingsdone);
+// read-only: would strat_singlecell do anything to this cell right now? (flag, reveal, or just mark it satisfied)
+bool singlecell_can_act(class game * g, class cell * me);
 
 
 ////////////////////////////////// two-cell strategies
@@ -244,19 +302,35 @@ int strat_singlecell(class cell * me, int * thingsdone);
 // looks for a specific arrangement of visible/unknown cells; if found, I can clear up to 2 cells.
 // unlike the other strategies, this isn't based in logic so much... this is just a pattern I noticed.
 // return: 1=win/-1=loss/0=continue (except cannot win, ever, and cannot lose unless something is seriously out of whack)
-int strat_121_cross(class cell * center, struct game_stats * gstats, int * thingsdone);
+int strat_121_cross(struct solvercontext * ctx, class cell * center, struct game_stats * gstats, int * thingsdone);
 //If two cells are X and X + 1, and the unknowns around X + 1 fall inside unknowns around X except for ONE, that
 //non-overlap cell must be a mine
 //Expanded to the general case: if two cells are X and X+Z, and X+Z has exactly Z unique cells, then all those cells must be mines
 // Compare against 5x5 region minus corners.
 // X(other) = 1/2/3/4,  Z = 1/2/3/4/5/6
 // return: 1=win/-1=loss/0=continue (except cannot lose here because it doesn't reveal cells here)
-int strat_nonoverlap_flag(class cell * center, struct game_stats * gstats, int * thingsdone);
+int strat_nonoverlap_flag(struct solvercontext * ctx, class cell * center, struct game_stats * gstats, int * thingsdone);
 //If the adj unknown tiles of a 1/2/3 -square are a pure subset of the adj unknown tiles of another
 //square with the same value, then the non-overlap section can be safely revealed!
 //Compare against any other same-value cell in the 5x5 region minus corners
 // return: 1=win/-1=loss/0=continue (except cannot win, ever, and cannot lose unless something is seriously out of whack)
-int strat_nonoverlap_safe(class cell * center, struct game_stats * gstats, int * thingsdone);
+int strat_nonoverlap_safe(struct solvercontext * ctx, class cell * center, struct game_stats * gstats, int * thingsdone);
+// the read-only halves of the three above: find the pattern/match and the cells it would change, but don't touch anything
+// these (and the other *_can_act functions) take the game explicitly, because the tiled logic runs them on the pool threads
+bool find_121_cross(class game * g, class cell * center, class cell ** c1, class cell ** c2);
+bool find_nonoverlap_flag(class game * g, class cell * center, struct adjlist * me_only);
+bool find_nonoverlap_safe(class game * g, class cell * center, struct adjlist * other_only);
+// read-only: would any of the three two-cell strategies do anything to this cell right now?
+bool twocell_can_act(class game * g, class cell * me);
+
+
+////////////////////////////////// tiled logic
+
+// work out in parallel (on the thread pool, one tile at a time) which cells of 'round' could possibly act, into 'out'
+// the caller still walks the round in order and runs the real strategy on a cell if it's a candidate OR if anything near it
+// has changed since (game::singlecell_changed_near / twocell_changed_near), so the result is exactly the serial result
+// returns false if the round is too small to bother (or there's only one thread); then every cell is a candidate
+bool find_round_candidates(struct solvercontext * ctx, const std::vector<class cell *> & round, bool (*can_act)(class game *, class cell *), std::vector<char> * out);
 
 
 
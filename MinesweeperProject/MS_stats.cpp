@@ -32,6 +32,7 @@ run_stats::run_stats() {
 		std::chrono::system_clock::now().time_since_epoch()
 		);
 	start = ms.count();
+	merged_ms = 0;
 	games_total = 0;
 	games_won = 0;
 	games_won_noguessing = 0;
@@ -48,27 +49,22 @@ run_stats::run_stats() {
 	num_guesses_in_wins = 0;
 	num_guesses_in_losses = 0; //
 	smartguess_attempts_total = 0;
-	smartguess_diff_total = 0.;
+	smartguess_diff_total = fixedsum();
 	smartguess_valves_tripped_total = 0;
 	games_with_smartguess_valves_tripped = 0;
 	games_with_eights = 0;
-	total_luck_in_wins = 0.; //
-	total_luck_in_losses = 0.; //
-	total_luck_per_guess = 0.;
+	total_luck_in_wins = fixedsum(); //
+	total_luck_in_losses = fixedsum(); //
+	total_luck_per_guess = fixedsum();
 
 	game_loss_histogram.clear();
 }
 
 
 // prints everything nice and formatted; only happens once, so it could be in-line but this is better encapsulation
-void run_stats::print_final_stats(class runinfo * runinfoptr) {
+void run_stats::print_final_stats(class runinfo * runinfoptr, bool findz, int gmode) {
 	// calculate total time elapsed and format for display
-	std::chrono::milliseconds ms = std::chrono::duration_cast< std::chrono::milliseconds >(
-		std::chrono::system_clock::now().time_since_epoch()
-		);
-	long f = ms.count();
-	int elapsed_ms = int(f - start); // currently in ms
-	double elapsed_sec = double(elapsed_ms) / 1000.; // seconds with a decimal
+	double elapsed_sec = double(elapsed_ms()) / 1000.; // seconds with a decimal
 
 	double sec = fmod(elapsed_sec, 60.);
 	int elapsed_min = int((elapsed_sec - sec) / 60.);
@@ -78,7 +74,7 @@ void run_stats::print_final_stats(class runinfo * runinfoptr) {
 	sprintf_s(timestr, "%i:%02i:%06.3f", hr, min, sec);
 
 	// print/log overall results (always print to terminal and log)
-	myprintfn(2, "\n\nDone playing all %i games, displaying results! Time = %s\n\n", runinfoptr->NUM_GAMES, timestr);
+	myprintfn(2, "\n\nDone playing all %i games, displaying results! Time = %s\n\n", games_total, timestr);
 
 	//if ((games_lost - game_loss_histogram[0]) > 50) {
 		print_histogram(HISTOGRAM_RESOLUTION);
@@ -90,31 +86,33 @@ void run_stats::print_final_stats(class runinfo * runinfoptr) {
 	myprintfn(2, "MinesweeperSolver version %s\n", VERSION_STRING_def);
 	myprintfn(2, "Games used X/Y/mines = %i/%i/%i, mine density = %4.3f%%\n", runinfoptr->get_SIZEX(), runinfoptr->get_SIZEY(), runinfoptr->get_NUM_MINES(),
 		float(100. * float(runinfoptr->get_NUM_MINES()) / float(runinfoptr->get_SIZEX() * runinfoptr->get_SIZEY())));
-	if (FIND_EARLY_ZEROS_var) {
+	if (findz) {
 		myprintfn(2, "Used 'hunting' method = zero-guess (uncover only zeroes until solving gets underway)\n");
 	} else {
 		myprintfn(2, "Used 'hunting' method = human-like (can lose at any stage)\n");
 	}
-	if (GUESSING_MODE_var == 0) {
+	if (gmode == 0) {
 		myprintfn(2, "Used 'guessing' mode = guess randomly (lower winrate but faster)\n");
 	} else {
-		if (GUESSING_MODE_var == 1) {
+		if (gmode == 1) {
 			myprintfn(2, "Used 'guessing' mode = smartguess (slower but increased winrate)\n");
-		} else if (GUESSING_MODE_var == 2) {
+		} else if (gmode == 2) {
 			myprintfn(2, "Used 'guessing' mode = perfectmode (experimental, maximum winrate)\n");
 		}
-		myprintfn(2, "    Smartguess border est. avg deviation:   %+8.4f\n", (smartguess_diff_total / float(smartguess_attempts_total)));
+		myprintfn(2, "    Smartguess border est. avg deviation:   %+8.4f\n", (smartguess_diff_total.get() / float(smartguess_attempts_total)));
 		myprintfn(2, "    Smartguess overflow count:           %6i\n", smartguess_valves_tripped_total);
 		myprintfn(2, "    Games with at least 1 overflow:      %6i\n", games_with_smartguess_valves_tripped);
 	}
 
 	myprintfn(2, "Average time per game:                     %9.4f sec\n", (float(elapsed_sec) / float(games_total)));
+	// per cell, so runs on different field sizes can be compared (should stay roughly flat as the field grows)
+	myprintfn(2, "Average time per cell:                     %9.4f usec\n", (1000000. * double(elapsed_sec) / (double(games_total) * double(myruninfo.get_SIZEX() * myruninfo.get_SIZEY()))));
 	myprintfn(2, "Average 121-cross uses per game:           %6.1f\n", (float(strat_121_total) / float(games_total)));
 	myprintfn(2, "Avg nonoverlap-flag (simple) per game:     %6.1f\n", (float(strat_nov_flag_total) / float(games_total)));
 	myprintfn(2, "Avg nonoverlap-safe (simple) per game:     %6.1f\n", (float(strat_nov_safe_total) / float(games_total)));
 	myprintfn(2, "Avg number of guesses needed to win:       %7.2f + initial guess\n", (float(num_guesses_in_wins) / float(games_won)));
-	myprintfn(2, "Average safety per guess:                  %8.3f%%\n", 100. * (float(total_luck_per_guess) / float(games_total + num_guesses_in_losses + num_guesses_in_wins))); // everything
-	//myprintfn(2, "Avg luck/safety value in each win:         %7.3f%%\n", 100. * (float(total_luck_in_wins) / float(games_won)));
+	myprintfn(2, "Average safety per guess:                  %8.3f%%\n", 100. * (float(total_luck_per_guess.get()) / float(games_total + num_guesses_in_losses + num_guesses_in_wins))); // everything
+	//myprintfn(2, "Avg luck/safety value in each win:         %7.3f%%\n", 100. * (float(total_luck_in_wins.get()) / float(games_won)));
 
 	// (1. - (float(runinfoptr->get_NUM_MINES()) / float(runinfoptr->get_SIZEX() * runinfoptr->get_SIZEY())));
 	// average luck per guess:
@@ -123,6 +121,9 @@ void run_stats::print_final_stats(class runinfo * runinfoptr) {
 	if (games_with_eights != 0) {
 	myprintfn(2, "    Games with 8-adj cells:              %6i\n", games_with_eights);
 	}
+	double lo, hi;
+	winrate_interval(&lo, &hi);
+	myprintfn(2, "Winrate 95%% interval (Wilson):           %7.3f%% to %.3f%%, +/- %.3f%%\n", 100. * lo, 100. * hi, 50. * (hi - lo));
 	myprintfn(2, "\n");
 	myprintfn(2, "Total games played:                     %7i\n", games_total);
 
@@ -131,7 +132,8 @@ void run_stats::print_final_stats(class runinfo * runinfoptr) {
 	myprintfn(2, "        Games won that required guessing:%6i   %5.1f%%   %5.1f%%\n", games_won_guessing, (100. * float(games_won_guessing) / float(games_total)), (100. * float(games_won_guessing) / float(games_won)));
 	myprintfn(2, "    Total games lost:                    %6i   %5.1f%%    -----\n", games_lost, (100. * float(games_lost) / float(games_total)));
 	myprintfn(2, "        Games lost before 1st flag (<1%%):%6i   %5.1f%%   %5.1f%%\n", game_loss_histogram[0], (100. * float(game_loss_histogram[0]) / float(games_total)), (100. * float(game_loss_histogram[0]) / float(games_lost)));
-	myprintfn(2, "        Games lost while solving (1-99%%):%6i   %5.1f%%   %5.1f%%\n", games_lost - game_loss_histogram[0], (100. * float(games_lost - game_loss_histogram[0]) / float(games_total)), (100. * float(games_lost - game_loss_histogram[0]) / float(games_lost)));
+	int solving = games_lost - game_loss_histogram[0] - games_lost_unexpectedly; // the unexpected ones aren't in the histogram
+	myprintfn(2, "        Games lost while solving (1-99%%):%6i   %5.1f%%   %5.1f%%\n", solving, (100. * float(solving) / float(games_total)), (100. * float(solving) / float(games_lost)));
 	// since I have the histogram I don't need to break it down further than "in the histogram vs not"
 	if (games_lost_unexpectedly != 0) {
 	myprintfn(2, "        Games lost unexpectedly:         %6i   %5.1f%%   %5.1f%%", games_lost_unexpectedly, (100. * float(games_lost_unexpectedly) / float(games_total)), (100. * float(games_lost_unexpectedly) / float(games_lost)));
@@ -168,6 +170,304 @@ void run_stats::init_histogram(int num_mines) {
 void run_stats::inc_histogram(int minesplaced) {
 	game_loss_histogram[minesplaced]++;
 }
+// add one finished game to the totals; also tags its transition map with W/X/? (result 1=win, 0=loss, -1=unexpected loss)
+void run_stats::absorb_game(int result, struct game_stats * gstats, int mines_remaining, int num_mines) {
+	strat_121_total +=		gstats->strat_121;
+	strat_nov_flag_total +=	gstats->strat_nov_flag;
+	strat_nov_safe_total +=	gstats->strat_nov_safe;
+	smartguess_attempts_total +=	gstats->smartguess_attempts;
+	smartguess_diff_total +=		gstats->smartguess_diff;
+	smartguess_valves_tripped_total += gstats->smartguess_valves_tripped;
+	games_with_smartguess_valves_tripped += bool(gstats->smartguess_valves_tripped);
+	total_luck_per_guess += gstats->luck_value_sum;
+
+	// increment run results depending on gamestate and gameresult
+	games_total++;
+	if (result == 0) { // game loss
+		gstats->trans_map += "X";
+		games_lost++;
+		inc_histogram(num_mines - mines_remaining);
+		// ................................. unused
+		num_guesses_in_losses += gstats->num_guesses;
+		total_luck_in_losses += gstats->luck_value_mult;
+		float remaining = float(mines_remaining) / float(num_mines);
+		if (remaining > 0.85) {
+			games_lost_earlygame++; // 0-15% completed
+		} else if (remaining > 0.15) {
+			games_lost_midgame++; // 15-85% completed
+		} else {
+			games_lost_lategame++; // 85-100% completed
+		}
+		// .................................
+	} else if (result == 1) { // game win
+		gstats->trans_map += "W";
+		games_won++;
+		num_guesses_in_wins += gstats->num_guesses;
+		total_luck_in_wins += gstats->luck_value_mult;
+		if (gstats->num_guesses > 0) {
+			games_won_guessing++;
+		} else {
+			games_won_noguessing++;
+		}
+	} else if (result == -1) {
+		gstats->trans_map += "?";
+		games_lost++;
+		games_lost_unexpectedly++;
+		assert(0);
+	}
+}
+// add a game that took its worker process down with it, as an unexpected loss outside the histogram
+void run_stats::absorb_crash() {
+	games_total++;
+	games_lost++;
+	games_lost_unexpectedly++;
+}
+// add another run_stats (from another worker thread) into this one; the start time stays mine
+void run_stats::merge(const struct run_stats & other) {
+	games_total += other.games_total;
+	games_won += other.games_won;
+	games_won_noguessing += other.games_won_noguessing;
+	games_won_guessing += other.games_won_guessing;
+	games_lost += other.games_lost;
+	games_lost_beginning += other.games_lost_beginning;
+	games_lost_earlygame += other.games_lost_earlygame;
+	games_lost_midgame += other.games_lost_midgame;
+	games_lost_lategame += other.games_lost_lategame;
+	games_lost_unexpectedly += other.games_lost_unexpectedly;
+	if (game_loss_histogram.size() < other.game_loss_histogram.size()) { game_loss_histogram.resize(other.game_loss_histogram.size(), 0); }
+	for (int i = 0; i < (int)other.game_loss_histogram.size(); i++) { game_loss_histogram[i] += other.game_loss_histogram[i]; }
+	strat_121_total += other.strat_121_total;
+	strat_nov_safe_total += other.strat_nov_safe_total;
+	strat_nov_flag_total += other.strat_nov_flag_total;
+	num_guesses_in_wins += other.num_guesses_in_wins;
+	num_guesses_in_losses += other.num_guesses_in_losses;
+	smartguess_attempts_total += other.smartguess_attempts_total;
+	smartguess_diff_total += other.smartguess_diff_total;
+	smartguess_valves_tripped_total += other.smartguess_valves_tripped_total;
+	games_with_smartguess_valves_tripped += other.games_with_smartguess_valves_tripped;
+	games_with_eights += other.games_with_eights;
+	total_luck_in_wins += other.total_luck_in_wins;
+	total_luck_in_losses += other.total_luck_in_losses;
+	total_luck_per_guess += other.total_luck_per_guess;
+	merged_ms += other.merged_ms;
+}
+// 95% Wilson score interval for the winrate, as fractions
+// unlike the plain p +/- z*sqrt(p(1-p)/n) it stays inside 0-1 and doesn't collapse to nothing when p is near 0 or 1
+void run_stats::winrate_interval(double * lo, double * hi) {
+	if (games_total == 0) { *lo = 0.; *hi = 1.; return; }
+	double n = double(games_total);
+	double p = double(games_won) / n;
+	double z2 = TARGET_CI_Z * TARGET_CI_Z;
+	double center = (p + (z2 / (2. * n))) / (1. + (z2 / n));
+	double half = (TARGET_CI_Z / (1. + (z2 / n))) * sqrt((p * (1. - p) / n) + (z2 / (4. * n * n)));
+	*lo = center - half;
+	*hi = center + half;
+}
+// ms since start, plus whatever came in with read_file
+long long run_stats::elapsed_ms() {
+	std::chrono::milliseconds ms = std::chrono::duration_cast< std::chrono::milliseconds >(
+		std::chrono::system_clock::now().time_since_epoch()
+		);
+	return (ms.count() - start) + merged_ms;
+}
+
+
+// the whole thing as a flat list of ints, for the stats files and the -workers shared memory: every counter in struct order
+// (the fixedsums as their raw value), then the histogram size, then the histogram
+int run_stats::flat_size() {
+	return STATS_FLAT_FIELDS + 1 + (int)game_loss_histogram.size();
+}
+void run_stats::pack(long long * out) {
+	long long * o = out;
+	*o++ = games_total;
+	*o++ = games_won; *o++ = games_won_noguessing; *o++ = games_won_guessing;
+	*o++ = games_lost; *o++ = games_lost_beginning; *o++ = games_lost_earlygame;
+	*o++ = games_lost_midgame; *o++ = games_lost_lategame; *o++ = games_lost_unexpectedly;
+	*o++ = strat_121_total; *o++ = strat_nov_safe_total; *o++ = strat_nov_flag_total;
+	*o++ = num_guesses_in_wins; *o++ = num_guesses_in_losses;
+	*o++ = smartguess_attempts_total; *o++ = smartguess_diff_total.raw; *o++ = smartguess_valves_tripped_total;
+	*o++ = games_with_smartguess_valves_tripped; *o++ = games_with_eights;
+	*o++ = total_luck_in_wins.raw; *o++ = total_luck_in_losses.raw; *o++ = total_luck_per_guess.raw;
+	assert(o - out == STATS_FLAT_FIELDS);
+	*o++ = game_loss_histogram.size();
+	for (int i = 0; i < (int)game_loss_histogram.size(); i++) { *o++ = game_loss_histogram[i]; }
+}
+// the reverse of pack; the histogram size must already have been checked
+void run_stats::unpack(const long long * in) {
+	const long long * v = in;
+	games_total = int(*v++);
+	games_won = int(*v++); games_won_noguessing = int(*v++); games_won_guessing = int(*v++);
+	games_lost = int(*v++); games_lost_beginning = int(*v++); games_lost_earlygame = int(*v++);
+	games_lost_midgame = int(*v++); games_lost_lategame = int(*v++); games_lost_unexpectedly = int(*v++);
+	strat_121_total = int(*v++); strat_nov_safe_total = int(*v++); strat_nov_flag_total = int(*v++);
+	num_guesses_in_wins = int(*v++); num_guesses_in_losses = int(*v++);
+	smartguess_attempts_total = int(*v++); smartguess_diff_total.raw = *v++; smartguess_valves_tripped_total = int(*v++);
+	games_with_smartguess_valves_tripped = int(*v++); games_with_eights = int(*v++);
+	total_luck_in_wins.raw = *v++; total_luck_in_losses.raw = *v++; total_luck_per_guess.raw = *v++;
+	int histsize = int(*v++);
+	game_loss_histogram.assign(histsize, 0);
+	for (int i = 0; i < histsize; i++) { game_loss_histogram[i] = int(*v++); }
+}
+
+
+// stats files are a magic string then a flat list of 8-byte little-endian ints, the same on any machine
+#define STATSFILE_MAGIC		"MSSTATS"
+#define STATSFILE_VERSION	1
+#define STATSFILE_HEADER	12 // version + the stats_header fields
+static void put64(FILE * fp, long long v) {
+	unsigned char b[8];
+	for (int i = 0; i < 8; i++) { b[i] = (unsigned char)((unsigned long long)v >> (8 * i)); }
+	fwrite(b, 1, 8, fp);
+}
+static bool get64(FILE * fp, long long * v) {
+	unsigned char b[8];
+	if (fread(b, 1, 8, fp) != 8) { return false; }
+	unsigned long long u = 0;
+	for (int i = 0; i < 8; i++) { u |= ((unsigned long long)b[i]) << (8 * i); }
+	*v = (long long)u;
+	return true;
+}
+// save everything to a compact binary file (-statsout) along with the header, which gets elapsed_ms filled in here
+// return 0 on success, 1 on failure
+int run_stats::write_file(const char * path, struct stats_header * hdr) {
+	FILE * fp = NULL;
+	fopen_s(&fp, path, "wb");
+	if (!fp) { myprintfn(2, "ERR: couldn't open stats file '%s' for writing\n", path); return 1; }
+	hdr->elapsed_ms = elapsed_ms();
+	fwrite(STATSFILE_MAGIC, 1, 8, fp); // includes the null
+	put64(fp, STATSFILE_VERSION);
+	// the header
+	put64(fp, hdr->sizex); put64(fp, hdr->sizey); put64(fp, hdr->num_mines);
+	put64(fp, hdr->findz); put64(fp, hdr->gmode);
+	put64(fp, (long long)hdr->runseed);
+	put64(fp, hdr->shard); put64(fp, hdr->num_shards); put64(fp, hdr->num_games);
+	put64(fp, hdr->elapsed_ms);
+	put64(fp, hdr->next_game);
+	// the stats
+	std::vector<long long> flat(flat_size());
+	pack(&flat[0]);
+	for (int i = 0; i < (int)flat.size(); i++) { put64(fp, flat[i]); }
+	bool ok = (ferror(fp) == 0);
+	if (fclose(fp) != 0) { ok = false; }
+	if (!ok) { myprintfn(2, "ERR: failed while writing stats file '%s'\n", path); return 1; }
+	return 0;
+}
+// load a file written by write_file in place of whatever this held; its time goes into merged_ms
+// return 0 on success, 1 on failure
+int run_stats::read_file(const char * path, struct stats_header * hdr) {
+	FILE * fp = NULL;
+	fopen_s(&fp, path, "rb");
+	if (!fp) { myprintfn(2, "ERR: couldn't open stats file '%s'\n", path); return 1; }
+	*this = run_stats();
+	char magic[8];
+	std::vector<long long> v(STATSFILE_HEADER + STATS_FLAT_FIELDS + 1); // everything up to and including the histogram size
+	if ((fread(magic, 1, 8, fp) != 8) || memcmp(magic, STATSFILE_MAGIC, 8)) {
+		myprintfn(2, "ERR: '%s' is not a stats file\n", path); fclose(fp); return 1;
+	}
+	for (int i = 0; i < (int)v.size(); i++) {
+		if (!get64(fp, &v[i])) { myprintfn(2, "ERR: stats file '%s' is truncated\n", path); fclose(fp); return 1; }
+	}
+	if (v[0] != STATSFILE_VERSION) {
+		myprintfn(2, "ERR: stats file '%s' is version %lli, I only read version %i\n", path, v[0], STATSFILE_VERSION); fclose(fp); return 1;
+	}
+	hdr->sizex = int(v[1]); hdr->sizey = int(v[2]); hdr->num_mines = int(v[3]);
+	hdr->findz = int(v[4]); hdr->gmode = int(v[5]);
+	hdr->runseed = (unsigned long long)v[6];
+	hdr->shard = int(v[7]); hdr->num_shards = int(v[8]); hdr->num_games = int(v[9]);
+	hdr->elapsed_ms = v[10];
+	hdr->next_game = int(v[11]);
+	long long histsize = v.back();
+	if ((histsize < 0) || (histsize > hdr->num_mines + 1)) {
+		myprintfn(2, "ERR: stats file '%s' has a bad histogram\n", path); fclose(fp); return 1;
+	}
+	v.resize(v.size() + histsize);
+	for (int i = (int)(v.size() - histsize); i < (int)v.size(); i++) {
+		if (!get64(fp, &v[i])) { myprintfn(2, "ERR: stats file '%s' is truncated\n", path); fclose(fp); return 1; }
+	}
+	fclose(fp);
+	unpack(&v[STATSFILE_HEADER]);
+	merged_ms = hdr->elapsed_ms;
+	return 0;
+}
+// size everything for n modes on a field with this many mines
+void paired_stats::init(int n, int num_mines) {
+	num_modes = n;
+	mode.assign(n, run_stats());
+	for (int m = 0; m < n; m++) { mode[m].init_histogram(num_mines); }
+	only_won.assign(n * n, 0);
+	dt_sum.assign(n * n, 0.);
+	dt_sq.assign(n * n, 0.);
+	ms_sum.assign(n, 0.);
+}
+// one board, once it has been played in every mode: 'won' and 'ms' have one entry per mode
+void paired_stats::absorb_board(const std::vector<int> & won, const std::vector<double> & ms) {
+	for (int a = 0; a < num_modes; a++) {
+		ms_sum[a] += ms[a];
+		for (int b = 0; b < num_modes; b++) {
+			if (won[a] && !won[b]) { only_won[(a * num_modes) + b]++; }
+			double d = ms[a] - ms[b];
+			dt_sum[(a * num_modes) + b] += d;
+			dt_sq[(a * num_modes) + b] += d * d;
+		}
+	}
+}
+// add another paired_stats (from another worker thread) into this one
+void paired_stats::merge(const struct paired_stats & other) {
+	for (int m = 0; m < num_modes; m++) {
+		mode[m].merge(other.mode[m]);
+		ms_sum[m] += other.ms_sum[m];
+	}
+	for (int i = 0; i < num_modes * num_modes; i++) {
+		only_won[i] += other.only_won[i];
+		dt_sum[i] += other.dt_sum[i];
+		dt_sq[i] += other.dt_sq[i];
+	}
+}
+// the per-mode results, then every pair of modes against each other: who won which boards, McNemar's test, time
+void paired_stats::print(const std::vector<std::string> & names) {
+	int n = mode[0].games_total; // every mode played every board
+	double dn = double(n);
+	myprintfn(2, "\n\nDone playing all %i boards in %i modes, displaying paired results! Time = %.3f sec\n\n", n, num_modes, double(mode[0].elapsed_ms()) / 1000.);
+	myprintfn(2, "Mode                         won   winrate  95%% +/-    ms/game\n");
+	for (int m = 0; m < num_modes; m++) {
+		double lo, hi;
+		mode[m].winrate_interval(&lo, &hi);
+		myprintfn(2, "%-22s %10i %8.3f%% %8.3f%% %10.4f\n", names[m].c_str(), mode[m].games_won, 100. * double(mode[m].games_won) / dn,
+			50. * (hi - lo), ms_sum[m] / dn);
+	}
+
+	myprintfn(2, "\nHead to head, on the same boards (95%% intervals):\n");
+	for (int a = 0; a < num_modes; a++) {
+		for (int b = a + 1; b < num_modes; b++) {
+			// only the boards where they disagree say anything about which is better
+			int onlya = only_won[(a * num_modes) + b];
+			int onlyb = only_won[(b * num_modes) + a];
+			int both = mode[a].games_won - onlya;
+			int neither = n - both - onlya - onlyb;
+			myprintfn(2, "%s vs %s:\n", names[a].c_str(), names[b].c_str());
+			myprintfn(2, "    Only the first won:%8i   only the second won:%8i   both won:%8i   both lost:%8i\n", onlya, onlyb, both, neither);
+			// winrate difference and its interval, paired: var = ((b+c) - (b-c)^2/n) / n^2
+			double diff = double(onlya - onlyb) / dn;
+			double half = TARGET_CI_Z * sqrt((double(onlya + onlyb) - (double(onlya - onlyb) * double(onlya - onlyb) / dn))) / dn;
+			// McNemar's test with the continuity correction: chi-squared with 1 degree of freedom, so p = erfc(sqrt(chi2 / 2))
+			double chi2 = 0., p = 1.;
+			if ((onlya + onlyb) > 0) {
+				double t = fabs(double(onlya - onlyb)) - 1.;
+				if (t < 0.) { t = 0.; }
+				chi2 = (t * t) / double(onlya + onlyb);
+				p = erfc(sqrt(chi2 / 2.));
+			}
+			myprintfn(2, "    Winrate difference:  %+8.3f%% +/- %.3f%%   McNemar chi2 = %.2f, p = %.4g\n", 100. * diff, 100. * half, chi2, p);
+			// time difference, from the per-board differences so the board-to-board variation cancels out too
+			double mean = dt_sum[(a * num_modes) + b] / dn;
+			double var = (n > 1) ? ((dt_sq[(a * num_modes) + b] - (dt_sum[(a * num_modes) + b] * mean)) / (dn - 1.)) : 0.;
+			if (var < 0.) { var = 0.; }
+			myprintfn(2, "    Time difference:     %+10.4f ms/game +/- %.4f\n", mean, TARGET_CI_Z * sqrt(var / dn));
+		}
+	}
+	myprintfn(2, "\n");
+	fflush(myruninfo.logfile);
+}
 // print a bar graph of the losses, configurable resolution
 // excludes any "first move" losses, game_loss_histogram[0]
 // NOTE: when displayed, bars will be horizontal rows, but when talking about it, I will picture them as vertical columns
@@ -191,7 +491,7 @@ void run_stats::print_histogram(int numrows) {
 	// to solve this, border zones must be split between the buckets they're going into
 	std::vector<float> new_histogram = std::vector<float>(numrows, 0);
 	int q = 0; // index of borders to be comparing against, and new_histogram bucket to put numbers into
-	for (int i = 1; i < game_loss_histogram.size(); i++) {
+	for (int i = 1; i < (int)game_loss_histogram.size(); i++) {
 		// is this entry in the middle of a bar, or does it need split?
 		if (border[q] < (float(i) + 0.5)) {
 			// i needs splitting; part goes into q, part goes into q+1
@@ -214,7 +514,7 @@ void run_stats::print_histogram(int numrows) {
 
 	// find max of the new histogram:
 	float z = 0;
-	for (int i = 0; i < new_histogram.size(); i++) {
+	for (int i = 0; i < (int)new_histogram.size(); i++) {
 		if (new_histogram[i] > z) z = new_histogram[i];
 	}
 
@@ -223,7 +523,7 @@ void run_stats::print_histogram(int numrows) {
 		myprintfn(2, "Distribution of when losses occur (in terms of game completion):\n");
 		myprintfn(2, " # games | 1%% of flags placed\n");
 		// for-loop
-		for (int i = 0; i < new_histogram.size(); i++) {
+		for (int i = 0; i < (int)new_histogram.size(); i++) {
 			std::string row = std::string(int(float(HISTOGRAM_MAX_HORIZ_SIZE) * new_histogram[i] / z), '#');
 			myprintfn(2, "%7.0f  |%s\n", new_histogram[i], row.c_str());
 		}
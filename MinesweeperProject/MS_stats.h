@@ -10,13 +10,11 @@
 #include <string> // for printing the histogram
 #include <vector> // used for histogram
 #include <chrono> // just because time(0) only has 1-second resolution
+#include <cmath> // llround
 
+#include "MS_settings.h" // STATS_FIXED_ONE
 
 
-// didn't wanna extern anything but whatever
-extern bool FIND_EARLY_ZEROS_var;
-extern int GUESSING_MODE_var;
-
 
 // stats for a single game
 struct game_stats {
@@ -44,12 +42,38 @@ struct game_stats {
 	void print_gamestats(int screen, class game * gameptr, class runinfo * runinfoptr);
 };
 
+// a running total of floats, kept as a fixed-point integer (STATS_FIXED_ONE steps per 1.0) instead of a float
+// each value is rounded once on the way in, after that it's integer adds, which give the same answer in any order
+// range: with 2^24 steps per 1.0 the total can reach +/- 2^39 (about 5.5e11) before the long long overflows; the values
+// added are at most a few units each (a guess's safety is 0-1), so that's hundreds of billions of guesses
+struct fixedsum {
+	fixedsum() { raw = 0; }
+
+	long long raw;
+
+	inline struct fixedsum& operator+=(const double& rhs) { raw += llround(rhs * STATS_FIXED_ONE); return *this; }
+	inline struct fixedsum& operator+=(const struct fixedsum& rhs) { raw += rhs.raw; return *this; }
+	inline double get() const { return double(raw) / STATS_FIXED_ONE; }
+};
+
+// what a stats file says about the run it came from, so shards of different runs can't get merged together by accident
+struct stats_header {
+	int sizex, sizey, num_mines;
+	int findz, gmode;
+	unsigned long long runseed;
+	int shard, num_shards;	// 1-based, 1/1 = the whole run
+	int num_games;			// in the whole run, not just this shard
+	long long elapsed_ms;	// how long this shard took to play
+	int next_game;			// every game in the shard before this one is in the stats (the end of the shard, unless it's a checkpoint)
+};
+
 // win/loss stats for a single program run
 struct run_stats {
 	// simple init, also sets start time
 	run_stats();
 
 	long start;
+	long long merged_ms;		// time spent playing the stats files merged in with read_file, added onto my own time
 	int games_total;			// total games played to conclusion (not really needed but w/e)
 
 	int games_won;				// total games won
@@ -74,23 +98,67 @@ struct run_stats {
 	int num_guesses_in_losses;
 
 	int smartguess_attempts_total;
-	float smartguess_diff_total;
+	struct fixedsum smartguess_diff_total;
 	int smartguess_valves_tripped_total;
 	int games_with_smartguess_valves_tripped;
 	int games_with_eights;
 
-	float total_luck_in_wins; //
-	float total_luck_in_losses; //
-	float total_luck_per_guess;
+	struct fixedsum total_luck_in_wins; //
+	struct fixedsum total_luck_in_losses; //
+	struct fixedsum total_luck_per_guess;
 
 	// prints everything nice and formatted; only happens once, so it could be in-line but this is better encapsulation
-	void print_final_stats(class runinfo * runinfoptr);
+	// findz/gmode are the hunting and guessing modes the games were played with, for the report
+	void print_final_stats(class runinfo * runinfoptr, bool findz, int gmode);
 	// once number of mines is known, set up the histogram
 	void init_histogram(int num_mines);
 	// increment the correct entry. could be in-line but this is better encapsulation
 	void inc_histogram(int minesplaced);
+	// add one finished game to the totals; also tags its transition map with W/X/? (result 1=win, 0=loss, -1=unexpected loss)
+	void absorb_game(int result, struct game_stats * gstats, int mines_remaining, int num_mines);
+	// add a game that took its worker process down with it: all that's known is that it didn't finish, so it's an
+	// unexpected loss (and stays out of the histogram, nobody knows how far it got)
+	void absorb_crash();
+	// add another run_stats (from another worker thread) into this one; the start time stays mine
+	// everything is integers, so merging in any order gives exactly the same totals as playing them all on one thread
+	void merge(const struct run_stats & other);
 	// print a bar graph of the losses, configurable resolution
 	void print_histogram(int numrows);
+	// ms since start, plus whatever came in with read_file
+	long long elapsed_ms();
+	// 95% Wilson score interval for the winrate, as fractions
+	void winrate_interval(double * lo, double * hi);
+	// save everything to a compact binary file (-statsout) along with the header, which gets elapsed_ms filled in here
+	// or load one back (-merge) in place of whatever this held; return 0 on success, 1 on failure
+	int write_file(const char * path, struct stats_header * hdr);
+	int read_file(const char * path, struct stats_header * hdr);
+	// the whole thing as a flat list of ints (for the stats files and the -workers shared memory), and back
+	int flat_size();
+	void pack(long long * out);
+	void unpack(const long long * in);
+};
+// how many ints pack() writes before the histogram
+#define STATS_FLAT_FIELDS	23
+
+
+// -paired: the same boards played under several modes, to compare the modes head to head
+// every comparison is on identical boards, so the luck of the boards cancels out and only the real difference is left
+struct paired_stats {
+	int num_modes;
+	std::vector<struct run_stats> mode;	// the usual totals, one per mode
+	std::vector<int> only_won;			// [a * num_modes + b]: boards mode a won and mode b lost
+	std::vector<double> dt_sum;			// [a * num_modes + b]: sum over all boards of (ms in mode a - ms in mode b)
+	std::vector<double> dt_sq;			// [a * num_modes + b]: same but squared, for the interval
+	std::vector<double> ms_sum;			// [mode]: total ms spent playing
+
+	// size everything for n modes on a field with this many mines
+	void init(int n, int num_mines);
+	// one board, once it has been played in every mode: 'won' and 'ms' have one entry per mode
+	void absorb_board(const std::vector<int> & won, const std::vector<double> & ms);
+	// add another paired_stats (from another worker thread) into this one
+	void merge(const struct paired_stats & other);
+	// the per-mode results, then every pair of modes against each other: who won which boards, McNemar's test, time
+	void print(const std::vector<std::string> & names);
 };
 
 
@@ -0,0 +1,90 @@
+// a tiny fixed-size thread pool for splitting one big job across cores
+
+
+
+#include "MS_threadpool.h" // include myself
+
+
+
+// basic constructor: no workers until init
+threadpool::threadpool() {
+	nthreads = 1;
+	job_now = NULL;
+	job_tasks = 0;
+	next_task = 0;
+	working = 0;
+	generation = 0;
+	quitting = false;
+}
+// stop and join the workers
+threadpool::~threadpool() {
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		quitting = true;
+	}
+	wake.notify_all();
+	for (int i = 0; i < (int)workers.size(); i++) { workers[i].join(); }
+}
+// start n-1 worker threads (the calling thread works too, so n threads in total); 1 = no threads, everything runs inline
+void threadpool::init(int n) {
+	if (n < 1) { n = 1; }
+	nthreads = n;
+	for (int i = 1; i < n; i++) {
+		workers.push_back(std::thread(&threadpool::worker_loop, this));
+	}
+}
+// grab tasks off the counter until there are none left
+void threadpool::do_tasks() {
+	while (true) {
+		int t = next_task.fetch_add(1);
+		if (t >= job_tasks) { return; }
+		(*job_now)(t);
+	}
+}
+// call job(t) once for every t in [0, ntasks), spread across the pool, and return once they have all finished
+void threadpool::run(int ntasks, const std::function<void(int)> & job) {
+	if ((nthreads == 1) || (ntasks == 1)) { // not worth waking anybody up
+		for (int t = 0; t < ntasks; t++) { job(t); }
+		return;
+	}
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		job_now = &job;
+		job_tasks = ntasks;
+		next_task = 0;
+		working = (int)workers.size();
+		generation++;
+	}
+	wake.notify_all();
+	do_tasks(); // the calling thread pitches in too
+	std::unique_lock<std::mutex> guard(lock);
+	done.wait(guard, [this] { return working == 0; });
+	job_now = NULL;
+}
+// cut [0, nitems) into contiguous tiles of 'tilesize' and call job(lo, hi) on each one, spread across the pool
+void threadpool::run_tiled(int nitems, int tilesize, const std::function<void(int, int)> & job) {
+	int ntiles = (nitems + tilesize - 1) / tilesize;
+	run(ntiles, [&](int t) {
+		int lo = t * tilesize;
+		int hi = lo + tilesize; if (hi > nitems) { hi = nitems; }
+		job(lo, hi);
+	});
+}
+// what each worker does forever: sleep until there's a new job, help with it, report back
+void threadpool::worker_loop() {
+	unsigned long long seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [this, seen] { return quitting || (generation != seen); });
+			if (quitting) { return; }
+			seen = generation;
+		}
+		do_tasks();
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			working--;
+			if (working == 0) { done.notify_one(); }
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#ifndef MS_THREADPOOL
+#define MS_THREADPOOL
+// a tiny fixed-size thread pool for splitting one big job (like analyzing every cell of a huge field) across cores
+// the threads are started once and sleep between jobs, so handing out a job costs a wake-up and nothing else
+
+
+
+#include <vector> // used
+#include <thread> // the workers
+#include <mutex> // job handoff
+#include <condition_variable> // sleeping workers
+#include <atomic> // task counter
+#include <functional> // the job
+
+
+
+class threadpool {
+public:
+	threadpool();
+	~threadpool();
+	// start n-1 worker threads (the calling thread works too, so n threads in total); 1 = no threads, everything runs inline
+	void init(int n);
+	// read-only accessor
+	inline int size() { return nthreads; }
+	// call job(t) once for every t in [0, ntasks), spread across the pool, and return once they have all finished
+	// the tasks run in no particular order, so each one must only write to its own outputs
+	void run(int ntasks, const std::function<void(int)> & job);
+	// cut [0, nitems) into contiguous tiles of 'tilesize' and call job(lo, hi) on each one, spread across the pool
+	void run_tiled(int nitems, int tilesize, const std::function<void(int, int)> & job);
+private:
+	int nthreads;
+	std::vector<std::thread> workers;
+	std::mutex lock;
+	std::condition_variable wake; // workers wait on this for a new job
+	std::condition_variable done; // run() waits on this for the workers to finish
+	const std::function<void(int)> * job_now;
+	int job_tasks;
+	std::atomic<int> next_task; // tasks are handed out first-come first-served
+	int working; // how many workers are still inside the current job
+	unsigned long long generation; // bumped for every job, so a worker can tell a new job from a spurious wake-up
+	bool quitting;
+	void worker_loop();
+	void do_tasks();
+};
+
+
+
+#endif
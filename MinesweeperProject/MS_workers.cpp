@@ -0,0 +1,145 @@
+// the shared memory block and worker processes for -workers
+
+
+
+#include "MS_settings.h"
+#include "MS_basegame.h" // need this for myprintfn
+#include "MS_stats.h"
+#include "MS_workers.h" // include myself
+
+
+
+// basic constructor: not mapped until create or open
+workerblock::workerblock() {
+	mapping = NULL;
+	base = NULL;
+	slotbytes = 0;
+	nslots = 0;
+	flat = 0;
+}
+workerblock::~workerblock() {
+	if (base != NULL) { UnmapViewOfFile(base); }
+	if (mapping != NULL) { CloseHandle(mapping); }
+}
+// map the whole block into my address space, once 'mapping' is open
+int workerblock::map(size_t bytes) {
+	base = (char *)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+	if (base == NULL) {
+		myprintfn(2, "ERR: couldn't map the worker block '%s'\n", blockname.c_str());
+		return 1;
+	}
+	return 0;
+}
+// supervisor: make a new block with room for n workers, each with 'flatsize' ints of stats; return 0 on success
+// named after my process id, so several supervisors on one machine don't collide
+int workerblock::create(int n, int flatsize) {
+	nslots = n; flat = flatsize;
+	slotbytes = sizeof(struct worker_slot) + (flat * sizeof(std::atomic<long long>));
+	blockname = "MinesweeperSolver_" + std::to_string(GetCurrentProcessId());
+	size_t bytes = slotbytes * nslots;
+	mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)bytes >> 32), (DWORD)bytes, blockname.c_str());
+	if (mapping == NULL) {
+		myprintfn(2, "ERR: couldn't create the worker block '%s'\n", blockname.c_str());
+		return 1;
+	}
+	if (map(bytes)) { return 1; }
+	for (int i = 0; i < nslots; i++) { reset(i); }
+	return 0;
+}
+// worker: attach to the supervisor's block by name; return 0 on success
+int workerblock::open(const char * name, int n, int flatsize) {
+	nslots = n; flat = flatsize;
+	slotbytes = sizeof(struct worker_slot) + (flat * sizeof(std::atomic<long long>));
+	blockname = name;
+	mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, blockname.c_str());
+	if (mapping == NULL) {
+		myprintfn(2, "ERR: couldn't open the worker block '%s'\n", blockname.c_str());
+		return 1;
+	}
+	return map(slotbytes * nslots);
+}
+struct worker_slot * workerblock::slot(int i) {
+	return (struct worker_slot *)(base + (slotbytes * i));
+}
+// supervisor: clear slot i before (re)starting a worker in it
+void workerblock::reset(int i) {
+	struct worker_slot * s = slot(i);
+	s->seq = 0;
+	s->playing = -1;
+	s->next_game = 0;
+	s->finished = 0;
+	for (int j = 0; j < flat; j++) { s->stats()[j] = 0; }
+}
+
+// worker: called after each game, with the stats so far and the next game to play
+// seqlock write side: seq goes odd, everything gets written, seq goes even again
+void workerblock::publish(int i, struct run_stats * stats, long long next_game) {
+	struct worker_slot * s = slot(i);
+	assert(stats->flat_size() == flat);
+	scratch.resize(flat);
+	stats->pack(&scratch[0]);
+	s->seq.fetch_add(1); // odd: the reader will wait or retry
+	for (int j = 0; j < flat; j++) { s->stats()[j].store(scratch[j], std::memory_order_relaxed); }
+	s->next_game.store(next_game, std::memory_order_relaxed);
+	s->seq.fetch_add(1, std::memory_order_release); // even again: the update is complete
+}
+// supervisor: a consistent copy of slot i's stats (and the next_game that goes with them), giving up after 'tries' attempts
+// seqlock read side: copy everything, and if seq was odd or changed in the meantime, do it again
+// bounded, because a worker that dies halfway thru publishing leaves seq odd forever
+bool workerblock::read(int i, struct run_stats * out, long long * next_game, int tries) {
+	struct worker_slot * s = slot(i);
+	scratch.resize(flat);
+	for (int t = 0; t < tries; t++) {
+		if (t != 0) { Sleep(0); }
+		long long before = s->seq.load(std::memory_order_acquire);
+		if (before & 1) { continue; } // mid-update
+		for (int j = 0; j < flat; j++) { scratch[j] = s->stats()[j].load(std::memory_order_relaxed); }
+		long long next = s->next_game.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (s->seq.load(std::memory_order_relaxed) != before) { continue; }
+		out->unpack(&scratch[0]); // if nothing was published yet it's all zeros, which unpacks as empty stats
+		*next_game = next;
+		return true;
+	}
+	return false;
+}
+
+
+
+// launch another copy of this exe with these args (not including the exe itself), no console window; return 0 on success
+// the worker's own crash dialogs are turned off on its end, so a crash just ends the process
+int launch_worker(const std::string & args, HANDLE * process) {
+	char exe[MAX_PATH];
+	GetModuleFileNameA(NULL, exe, MAX_PATH);
+	std::string cmdline = "\"" + std::string(exe) + "\" " + args;
+	STARTUPINFOA si;
+	PROCESS_INFORMATION pi;
+	memset(&si, 0, sizeof(si));
+	si.cb = sizeof(si);
+	memset(&pi, 0, sizeof(pi));
+	// CreateProcess wants a writable command line
+	std::vector<char> buf(cmdline.begin(), cmdline.end());
+	buf.push_back('\0');
+	if (!CreateProcessA(exe, &buf[0], NULL, NULL, FALSE, CREATE_NO_WINDOW, NULL, NULL, &si, &pi)) {
+		myprintfn(2, "ERR: couldn't start worker '%s'\n", cmdline.c_str());
+		return 1;
+	}
+	CloseHandle(pi.hThread);
+	*process = pi.hProcess;
+	return 0;
+}
+// has it exited? if so, fill in the exit code and close the handle
+bool worker_exited(HANDLE process, unsigned long * exitcode) {
+	if (WaitForSingleObject(process, 0) != WAIT_OBJECT_0) { return false; }
+	DWORD code = 0;
+	GetExitCodeProcess(process, &code);
+	*exitcode = code;
+	CloseHandle(process);
+	return true;
+}
+// kill a hung worker and close the handle
+void kill_worker(HANDLE process) {
+	TerminateProcess(process, 1);
+	WaitForSingleObject(process, INFINITE);
+	CloseHandle(process);
+}
@@ -0,0 +1,70 @@
+#ifndef MS_WORKERS
+#define MS_WORKERS
+// -workers: the games are split across separate worker processes (more copies of this exe) so a crash or a hang in
+// one game can only take down its own worker. each worker publishes its run_stats into its slot of a shared memory
+// block after every game, so when one dies nothing it finished is lost, and the supervisor restarts it past the bad game
+
+
+
+#include <vector> // used
+#include <string> // block name, command lines
+#include <atomic> // the slots are read and written from different processes
+#include <Windows.h> // file mappings and processes
+
+
+
+// one worker's slot in the shared block, followed directly by the packed run_stats (run_stats::pack)
+// only the worker writes to it while it's alive, only the supervisor reads it; 'seq' makes it a seqlock so the
+// supervisor never sees half of an update, and also serves as the heartbeat (it changes after every game)
+struct worker_slot {
+	std::atomic<long long> seq;			// odd while the worker is in the middle of publishing
+	std::atomic<long long> playing;		// game index being played right now, -1 between games
+	std::atomic<long long> next_game;	// everything in my range before this is finished and counted in the stats
+	std::atomic<long long> finished;	// 1 once the whole range is done
+	inline std::atomic<long long> * stats() { return (std::atomic<long long> *)(this + 1); }
+};
+
+
+class workerblock {
+public:
+	workerblock();
+	~workerblock();
+	// supervisor: make a new block with room for n workers, each with 'flatsize' ints of stats; return 0 on success
+	int create(int n, int flatsize);
+	// worker: attach to the supervisor's block by name; return 0 on success
+	int open(const char * name, int n, int flatsize);
+	// read-only accessors
+	inline const char * name() { return blockname.c_str(); }
+	struct worker_slot * slot(int i);
+	// worker: called after each game, with the stats so far and the next game to play
+	void publish(int i, struct run_stats * stats, long long next_game);
+	// supervisor: a consistent copy of slot i's stats (and the next_game that goes with them), giving up after 'tries' attempts
+	// return false if every attempt caught the worker mid-publish, and then 'out' and 'next_game' are untouched
+	// a dead worker's slot never changes again, so 1 try is enough: if it's mid-publish then, it died there and the slot is torn
+	bool read(int i, struct run_stats * out, long long * next_game, int tries);
+	// supervisor: clear slot i before (re)starting a worker in it (seq goes back to 0, even, in case it died mid-publish)
+	void reset(int i);
+private:
+	HANDLE mapping;
+	char * base;
+	size_t slotbytes;
+	int nslots;
+	int flat; // ints of stats per slot
+	std::string blockname;
+	std::vector<long long> scratch;
+	int map(size_t bytes);
+};
+
+
+// launch another copy of this exe with these args (not including the exe itself), no console window; return 0 on success
+int launch_worker(const std::string & args, HANDLE * process);
+// has it exited? if so, fill in the exit code and close the handle
+bool worker_exited(HANDLE process, unsigned long * exitcode);
+// kill a hung worker and close the handle
+void kill_worker(HANDLE process);
+
+
+
+
+
+#endif
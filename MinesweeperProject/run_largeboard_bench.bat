@@ -0,0 +1,10 @@
+@ECHO OFF
+ECHO beginning large-board scaling benchmark, same density (15%%) at 4 field sizes
+ECHO compare the "Average time per cell" lines, they should stay roughly flat as the field grows
+PAUSE
+..\x64\Release\MinesweeperProject.exe -numgames 200 -field 250-250-9375 -findz 1 -gmode 2 -scr -1
+..\x64\Release\MinesweeperProject.exe -numgames 50 -field 500-500-37500 -findz 1 -gmode 2 -scr -1
+..\x64\Release\MinesweeperProject.exe -numgames 20 -field 1000-1000-150000 -findz 1 -gmode 2 -scr -1
+..\x64\Release\MinesweeperProject.exe -numgames 5 -field 2000-2000-600000 -findz 1 -gmode 2 -scr -1
+ECHO EVERYTHING DONE!!
+PAUSE
@@ -0,0 +1,14 @@
+@ECHO OFF
+ECHO splitting one run into 4 shards, each its own process, then merging the stats files into one report
+ECHO every shard must get the same -runseed, -numgames and settings; on a batch farm just run each line on a different machine
+PAUSE
+:: the parentheses-and-pipe trick makes this wait until all 4 shards have finished
+(
+START "" /B ..\x64\Release\MinesweeperProject.exe -numgames 100000 -field 30-16-99 -findz 0 -gmode 2 -scr -1 -runseed 12345 -shard 1/4 -statsout shard1.msstats
+START "" /B ..\x64\Release\MinesweeperProject.exe -numgames 100000 -field 30-16-99 -findz 0 -gmode 2 -scr -1 -runseed 12345 -shard 2/4 -statsout shard2.msstats
+START "" /B ..\x64\Release\MinesweeperProject.exe -numgames 100000 -field 30-16-99 -findz 0 -gmode 2 -scr -1 -runseed 12345 -shard 3/4 -statsout shard3.msstats
+START "" /B ..\x64\Release\MinesweeperProject.exe -numgames 100000 -field 30-16-99 -findz 0 -gmode 2 -scr -1 -runseed 12345 -shard 4/4 -statsout shard4.msstats
+) | SET /P "="
+..\x64\Release\MinesweeperProject.exe -merge shard1.msstats shard2.msstats shard3.msstats shard4.msstats
+ECHO EVERYTHING DONE!!
+PAUSE